@@ -2,8 +2,26 @@
 #include "streams.inl"
 #include "string.inl"
 #include "stringbuilder.inl"
+#include "stringbuilderpool.inl"
 #include "stringiterator.inl"
 #include "tostring.inl"
 #include "tryparse.inl"
 #include "converter_utf8.inl"
-#include "converter_utf16.inl"
\ No newline at end of file
+#include "converter_utf16.inl"
+#include "pattern.inl"
+#include "fuzzy.inl"
+#include "radixtree.inl"
+#include "frontcoded.inl"
+#include "symboltable.inl"
+#include "trigramindex.inl"
+#include "stringswitch.inl"
+#include "sharedstringtable.inl"
+#include "stringhandle.inl"
+#include "serialization.inl"
+#include "lineindex.inl"
+#include "inplacestringbuilder.inl"
+#include "join.inl"
+#include "json.inl"
+#include "logger.inl"
+#include "appendto.inl"
+#include "tostring_shortest.inl"
\ No newline at end of file
@@ -0,0 +1,36 @@
+#pragma once
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "stringbuilder.hpp"
+
+namespace jht {
+
+	/// @brief Appends the characters of text. They are copied, so text does not have to outlive the builder
+	inline void AppendTo(StringBuilder& builder, std::string_view text);
+	/// @brief Appends the characters of text. They are copied, so text does not have to outlive the builder
+	inline void AppendTo(StringBuilder& builder, const std::string& text);
+	/// @brief Appends the elements of values as "[a, b, c]"
+	template<typename T, typename TAllocator>
+	void AppendTo(StringBuilder& builder, const std::vector<T, TAllocator>& values);
+	/// @brief Appends pair as "(first, second)"
+	template<typename TFirst, typename TSecond>
+	void AppendTo(StringBuilder& builder, const std::pair<TFirst, TSecond>& pair);
+	/// @brief Appends the contained value, or "null" if there is none
+	template<typename T>
+	void AppendTo(StringBuilder& builder, const std::optional<T>& value);
+
+	namespace appendto
+	{
+		/// @brief True if StringBuilder can append T through an AppendTo overload, found in namespace jht or by argument dependent lookup
+		/// @details Make a type appendable by declaring void AppendTo(jht::StringBuilder&, const T&) in the namespace of T
+		template<typename T, typename = void>
+		struct HasAppendTo : std::false_type {};
+
+		template<typename T>
+		struct HasAppendTo<T, std::void_t<decltype(AppendTo(std::declval<StringBuilder&>(), std::declval<const T&>()))>> : std::true_type {};
+	}
+}
\ No newline at end of file
@@ -0,0 +1,46 @@
+#pragma once
+#include "appendto.hpp"
+
+namespace jht
+{
+	inline void AppendTo(StringBuilder& builder, std::string_view text)
+	{
+		builder.AppendCopy(text.data(), text.length());
+	}
+
+	inline void AppendTo(StringBuilder& builder, const std::string& text)
+	{
+		builder.AppendCopy(text.data(), text.length());
+	}
+
+	template<typename T, typename TAllocator>
+	inline void AppendTo(StringBuilder& builder, const std::vector<T, TAllocator>& values)
+	{
+		builder << '[';
+		for (size_t index = 0; index < values.size(); index++)
+		{
+			if (index > 0) {
+				builder << ", ";
+			}
+			builder << values[index];
+		}
+		builder << ']';
+	}
+
+	template<typename TFirst, typename TSecond>
+	inline void AppendTo(StringBuilder& builder, const std::pair<TFirst, TSecond>& pair)
+	{
+		builder << '(' << pair.first << ", " << pair.second << ')';
+	}
+
+	template<typename T>
+	inline void AppendTo(StringBuilder& builder, const std::optional<T>& value)
+	{
+		if (value.has_value()) {
+			builder << *value;
+		}
+		else {
+			builder << "null";
+		}
+	}
+}
\ No newline at end of file
@@ -8,6 +8,14 @@ using fp32_t = float;
 using fp64_t = double;
 using index_t = ptrdiff_t;
 
+#pragma endregion
+#pragma region SIMD availability
+
+#if !defined(JHT_STRING_NOSIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define JHT_STRING_SSE2
+#include <emmintrin.h>
+#endif
+
 #pragma endregion
 
 namespace jht
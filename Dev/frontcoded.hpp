@@ -0,0 +1,77 @@
+#pragma once
+#include <vector>
+#include "string.hpp"
+
+namespace jht {
+
+	/// @brief Read-only dictionary of sorted unique strings, compressed by front coding
+	/// @details Keys are stored in blocks. The first key of each block is stored in full, every further key only stores the length of
+	/// the prefix it shares with its predecessor followed by the remaining suffix. Keys are ordered by unsigned byte value.
+	/// Lookups compare against the encoded data directly and do not decode or allocate.
+	class FrontCodedDictionary
+	{
+	private:
+		size_t m_BlockSize;
+		size_t m_Count;
+		std::vector<uint8_t> m_Data;
+		std::vector<uint64_t> m_BlockOffsets;
+
+		String BlockHead(size_t block, const uint8_t*& next) const;
+		size_t Search(const String& key, bool prefixMode, bool& found) const;
+
+	public:
+		/// @brief Default count of keys per block
+		static const size_t DEFAULTBLOCKSIZE = 16;
+
+		/// @brief Iterates keys in order. Block heads are exposed as views into the dictionary, all other keys as views into a buffer owned by the iterator
+		class Iterator
+		{
+		private:
+			const FrontCodedDictionary* m_Dictionary;
+			size_t m_Index;
+			const uint8_t* m_Next;
+			std::vector<char> m_Buffer;
+			String m_Current;
+
+			void Decode();
+		public:
+			/// @param startIndex rank of the first key to visit
+			Iterator(const FrontCodedDictionary& dictionary, size_t startIndex = 0);
+
+			/// @brief Exposes the current key. Stays valid until the iterator advances
+			const String& operator*() const { return m_Current; }
+			/// @brief Exposes the current key. Stays valid until the iterator advances
+			const String& Current() const { return m_Current; }
+			/// @brief Advances the iterator to the next key
+			void operator++();
+			/// @brief Returns true if the iterator points to a key
+			operator bool() const { return m_Index < m_Dictionary->m_Count; }
+			/// @brief Rank of the current key
+			size_t Index() const { return m_Index; }
+		};
+
+		/// @param blockSize count of keys per block. Larger blocks compress better, smaller blocks decode faster
+		FrontCodedDictionary(size_t blockSize = DEFAULTBLOCKSIZE) : m_BlockSize(max(blockSize, size_t(1))), m_Count(0), m_Data(), m_BlockOffsets() {}
+
+		/// @brief Replaces the content of the dictionary
+		/// @param sortedKeys keys in strictly ascending order (by unsigned byte value)
+		/// @return false if the keys are not sorted or not unique, the dictionary is left empty then
+		bool Build(const std::vector<String>& sortedKeys);
+
+		/// @brief Count of stored keys
+		size_t Count() const { return m_Count; }
+		/// @brief Bytes allocated by the dictionary
+		size_t MemoryUsage() const;
+
+		/// @brief Looks up the rank of a key
+		/// @param index receives the rank if the key is found
+		/// @return true if the key is stored
+		bool Find(const String& key, size_t& index) const;
+		/// @brief Count of stored keys that are smaller than key (the rank key would have)
+		size_t LowerBound(const String& key) const;
+		/// @brief Returns the key of a given rank. Block heads are returned as views, other keys are decoded into a managed String
+		String Get(size_t index) const;
+		/// @brief Finds the rank range [begin, end) of all keys starting with prefix
+		void PrefixRange(const String& prefix, size_t& begin, size_t& end) const;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,276 @@
+#pragma once
+#include "frontcoded.hpp"
+#include "varint.hpp"
+#include <cassert>
+
+namespace jht
+{
+	namespace frontcoded
+	{
+		/// @brief Compares an entry section against key, both starting at offset. In prefix mode keys starting with key order before it
+		/// @param common receives the length of the prefix shared by the whole entry and key
+		inline int32_t CompareFrom(const char* entry, size_t entryLength, const String& key, size_t offset, bool prefixMode, size_t& common)
+		{
+			const char* keyData = key.Data() + offset;
+			size_t keyRemaining = key.Length() - offset;
+			size_t length = min(entryLength, keyRemaining);
+			size_t index = 0;
+			while (index < length && entry[index] == keyData[index])
+			{
+				index++;
+			}
+			common = offset + index;
+			if (index < length)
+			{
+				return static_cast<uint8_t>(entry[index]) < static_cast<uint8_t>(keyData[index]) ? -1 : 1;
+			}
+			if (index == keyRemaining)
+			{
+				if (prefixMode)
+				{
+					return -1;
+				}
+				return entryLength == keyRemaining ? 0 : 1;
+			}
+			return -1;
+		}
+	}
+
+#pragma region Building
+
+	inline bool FrontCodedDictionary::Build(const std::vector<String>& sortedKeys)
+	{
+		m_Count = 0;
+		m_Data.clear();
+		m_BlockOffsets.clear();
+
+		size_t previousLength = 0;
+		for (size_t index = 0; index < sortedKeys.size(); index++)
+		{
+			const String& key = sortedKeys[index];
+			size_t common = 0;
+			if (index > 0 && frontcoded::CompareFrom(sortedKeys[index - 1].Data(), previousLength, key, 0, false, common) >= 0)
+			{
+				m_Data.clear();
+				m_BlockOffsets.clear();
+				return false;
+			}
+			if (index % m_BlockSize == 0)
+			{
+				m_BlockOffsets.push_back(m_Data.size());
+				varint::Append(m_Data, key.Length());
+				m_Data.insert(m_Data.end(), key.Data(), key.Data() + key.Length());
+			}
+			else
+			{
+				varint::Append(m_Data, common);
+				varint::Append(m_Data, key.Length() - common);
+				m_Data.insert(m_Data.end(), key.Data() + common, key.Data() + key.Length());
+			}
+			previousLength = key.Length();
+		}
+		m_Data.shrink_to_fit();
+		m_BlockOffsets.shrink_to_fit();
+		m_Count = sortedKeys.size();
+		return true;
+	}
+
+	inline size_t FrontCodedDictionary::MemoryUsage() const
+	{
+		return sizeof(FrontCodedDictionary) + m_Data.capacity() + m_BlockOffsets.capacity() * sizeof(uint64_t);
+	}
+
+#pragma endregion
+#pragma region Lookup
+
+	inline String FrontCodedDictionary::BlockHead(size_t block, const uint8_t*& next) const
+	{
+		const uint8_t* data = m_Data.data() + m_BlockOffsets[block];
+		size_t length = static_cast<size_t>(varint::DecodeUnchecked(data));
+		next = data + length;
+		return String(reinterpret_cast<const char*>(data), length);
+	}
+
+	inline size_t FrontCodedDictionary::Search(const String& key, bool prefixMode, bool& found) const
+	{
+		found = false;
+		const uint8_t* next = nullptr;
+		size_t common = 0;
+
+		// Binary search for the first block whose head orders after key
+		size_t low = 0;
+		size_t high = m_BlockOffsets.size();
+		while (low < high)
+		{
+			size_t middle = low + (high - low) / 2;
+			String head = BlockHead(middle, next);
+			if (frontcoded::CompareFrom(head.ConstData(), head.Length(), key, 0, prefixMode, common) <= 0)
+			{
+				low = middle + 1;
+			}
+			else
+			{
+				high = middle;
+			}
+		}
+		if (low == 0)
+		{
+			return 0;
+		}
+
+		size_t block = low - 1;
+		size_t index = block * m_BlockSize;
+		String head = BlockHead(block, next);
+		if (frontcoded::CompareFrom(head.ConstData(), head.Length(), key, 0, prefixMode, common) == 0)
+		{
+			found = true;
+			return index;
+		}
+
+		// Scan the block. 'matched' is the prefix the previous entry (which orders before key) shares with key.
+		// An entry sharing less with its predecessor orders after key, an entry sharing more orders before key.
+		size_t matched = common;
+		size_t end = min(index + m_BlockSize, m_Count);
+		for (index++; index < end; index++)
+		{
+			size_t shared = static_cast<size_t>(varint::DecodeUnchecked(next));
+			size_t suffixLength = static_cast<size_t>(varint::DecodeUnchecked(next));
+			const char* suffix = reinterpret_cast<const char*>(next);
+			next += suffixLength;
+			if (shared < matched)
+			{
+				return index;
+			}
+			if (shared > matched)
+			{
+				continue;
+			}
+			int32_t comparison = frontcoded::CompareFrom(suffix, suffixLength, key, matched, prefixMode, common);
+			if (comparison == 0)
+			{
+				found = true;
+				return index;
+			}
+			if (comparison > 0)
+			{
+				return index;
+			}
+			matched = common;
+		}
+		return end;
+	}
+
+	inline bool FrontCodedDictionary::Find(const String& key, size_t& index) const
+	{
+		bool found = false;
+		size_t rank = Search(key, false, found);
+		if (found)
+		{
+			index = rank;
+		}
+		return found;
+	}
+
+	inline size_t FrontCodedDictionary::LowerBound(const String& key) const
+	{
+		bool found = false;
+		return Search(key, false, found);
+	}
+
+	inline void FrontCodedDictionary::PrefixRange(const String& prefix, size_t& begin, size_t& end) const
+	{
+		bool found = false;
+		begin = Search(prefix, false, found);
+		end = Search(prefix, true, found);
+	}
+
+	inline String FrontCodedDictionary::Get(size_t index) const
+	{
+#ifndef JHT_STRING_NOASSERT
+		assert(index < m_Count && "Index invalid!");
+#endif
+		const uint8_t* next = nullptr;
+		String head = BlockHead(index / m_BlockSize, next);
+		size_t position = index % m_BlockSize;
+		if (position == 0)
+		{
+			return head;
+		}
+
+		// First pass finds the decoded length, the second writes each entry's suffix over its predecessor
+		const uint8_t* entries = next;
+		size_t length = 0;
+		for (size_t entry = 1; entry <= position; entry++)
+		{
+			size_t shared = static_cast<size_t>(varint::DecodeUnchecked(next));
+			size_t suffixLength = static_cast<size_t>(varint::DecodeUnchecked(next));
+			next += suffixLength;
+			length = shared + suffixLength;
+		}
+
+		String result = String::MakeManaged(length);
+		if (length == 0)
+		{
+			return result;
+		}
+		char* data = result.Data();
+		memcpy(data, head.ConstData(), min(head.Length(), length));
+		next = entries;
+		for (size_t entry = 1; entry <= position; entry++)
+		{
+			size_t shared = static_cast<size_t>(varint::DecodeUnchecked(next));
+			size_t suffixLength = static_cast<size_t>(varint::DecodeUnchecked(next));
+			if (shared < length)
+			{
+				memcpy(data + shared, next, min(suffixLength, length - shared));
+			}
+			next += suffixLength;
+		}
+		return result;
+	}
+
+#pragma endregion
+#pragma region Iterator
+
+	inline FrontCodedDictionary::Iterator::Iterator(const FrontCodedDictionary& dictionary, size_t startIndex)
+		: m_Dictionary(&dictionary), m_Index(startIndex - startIndex % dictionary.m_BlockSize), m_Next(nullptr), m_Buffer(), m_Current()
+	{
+		if (m_Index >= m_Dictionary->m_Count)
+		{
+			m_Index = startIndex;
+			return;
+		}
+		Decode();
+		while (m_Index < startIndex && m_Index < m_Dictionary->m_Count)
+		{
+			++(*this);
+		}
+	}
+
+	inline void FrontCodedDictionary::Iterator::Decode()
+	{
+		if (m_Index % m_Dictionary->m_BlockSize == 0)
+		{
+			m_Current = m_Dictionary->BlockHead(m_Index / m_Dictionary->m_BlockSize, m_Next);
+			m_Buffer.assign(m_Current.ConstData(), m_Current.ConstData() + m_Current.Length());
+			return;
+		}
+		size_t shared = static_cast<size_t>(varint::DecodeUnchecked(m_Next));
+		size_t suffixLength = static_cast<size_t>(varint::DecodeUnchecked(m_Next));
+		m_Buffer.resize(shared);
+		m_Buffer.insert(m_Buffer.end(), m_Next, m_Next + suffixLength);
+		m_Next += suffixLength;
+		m_Current = String(m_Buffer.data(), m_Buffer.size());
+	}
+
+	inline void FrontCodedDictionary::Iterator::operator++()
+	{
+		m_Index++;
+		if (m_Index < m_Dictionary->m_Count)
+		{
+			Decode();
+		}
+	}
+
+#pragma endregion
+}
\ No newline at end of file
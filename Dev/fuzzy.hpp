@@ -0,0 +1,49 @@
+#pragma once
+#include <vector>
+#include "string.hpp"
+
+namespace jht {
+
+	/// @brief Computes the Levenshtein distance between two strings (bit-parallel, O(ceil(m/64) * n))
+	/// @param maxDistance distances above this bound are not computed exactly. The function exits early and returns maxDistance + 1 instead
+	inline size_t EditDistance(const String& a, const String& b, size_t maxDistance = SIZE_MAX);
+
+	/// @brief A single result of a fuzzy search
+	struct FuzzyMatch
+	{
+		/// @brief Index of the candidate in the searched collection
+		size_t Index;
+		/// @brief Levenshtein distance between query and candidate
+		size_t Distance;
+	};
+
+	/// @brief Compares one query against many candidates, preprocessing the query only once
+	class FuzzyMatcher
+	{
+	private:
+		String m_Query;
+		size_t m_Blocks;
+		std::vector<uint64_t> m_Peq;
+		mutable std::vector<uint64_t> m_Pv;
+		mutable std::vector<uint64_t> m_Mv;
+
+	public:
+		/// @param query the string all candidates are compared against
+		FuzzyMatcher(const String& query);
+
+		/// @brief The query this matcher compares against
+		const String& Query() const { return m_Query; }
+
+		/// @brief Computes the Levenshtein distance between query and text
+		/// @param maxDistance distances above this bound are not computed exactly. The function exits early and returns maxDistance + 1 instead
+		size_t Distance(const String& text, size_t maxDistance = SIZE_MAX) const;
+
+		/// @brief Finds the k candidates closest to the query. Candidates whose length alone rules them out are skipped without comparison
+		/// @param maxDistance candidates further away than this are never reported
+		/// @param out receives up to k matches, ordered by distance then index
+		void Search(const std::vector<String>& candidates, size_t k, size_t maxDistance, std::vector<FuzzyMatch>& out) const;
+	};
+
+	/// @brief Finds the k candidates closest to query (see FuzzyMatcher::Search)
+	inline void FuzzySearch(const std::vector<String>& candidates, const String& query, size_t k, size_t maxDistance, std::vector<FuzzyMatch>& out);
+}
\ No newline at end of file
@@ -0,0 +1,182 @@
+#pragma once
+#include "fuzzy.hpp"
+#include <algorithm>
+
+namespace jht
+{
+	namespace fuzzy
+	{
+		const size_t WORDBITS = 64;
+		const uint64_t HIGHBIT = uint64_t(1) << 63;
+
+		/// @brief Myers/Hyyroe bit-parallel Levenshtein distance. The pattern is split into 64 row blocks, horizontal deltas carry from block to block
+		/// @param peq pattern match masks, laid out as [character][block]
+		/// @param pv @param mv scratch space for one word per block
+		inline size_t BitParallelDistance(const uint64_t* peq, size_t blocks, size_t patternLength, const uint8_t* text, size_t textLength, size_t maxDistance, uint64_t* pv, uint64_t* mv)
+		{
+			const size_t lastBlock = blocks - 1;
+			const uint64_t lastBit = uint64_t(1) << ((patternLength - 1) % WORDBITS);
+			for (size_t block = 0; block < blocks; block++)
+			{
+				pv[block] = ~uint64_t(0);
+				mv[block] = 0;
+			}
+
+			size_t score = patternLength;
+			for (size_t column = 0; column < textLength; column++)
+			{
+				const uint64_t* eqColumn = peq + static_cast<size_t>(text[column]) * blocks;
+				int32_t carry = 1; // the top row grows by one per column
+				for (size_t block = 0; block < blocks; block++)
+				{
+					uint64_t eq = eqColumn[block];
+					const uint64_t pvBlock = pv[block];
+					const uint64_t mvBlock = mv[block];
+					const uint64_t carryNeg = carry < 0 ? 1 : 0;
+
+					const uint64_t xv = eq | mvBlock;
+					eq |= carryNeg;
+					const uint64_t xh = (((eq & pvBlock) + pvBlock) ^ pvBlock) | eq;
+					uint64_t ph = mvBlock | ~(xh | pvBlock);
+					uint64_t mh = pvBlock & xh;
+
+					const uint64_t outBit = block == lastBlock ? lastBit : HIGHBIT;
+					const int32_t carryOut = (ph & outBit) ? 1 : ((mh & outBit) ? -1 : 0);
+
+					ph = (ph << 1) | (carry > 0 ? 1 : 0);
+					mh = (mh << 1) | carryNeg;
+					pv[block] = mh | ~(xv | ph);
+					mv[block] = ph & xv;
+					carry = carryOut;
+				}
+				if (carry > 0)
+				{
+					score++;
+				}
+				else if (carry < 0)
+				{
+					score--;
+				}
+
+				// Each remaining column can lower the score by at most one
+				const size_t remaining = textLength - column - 1;
+				if (score > remaining && score - remaining > maxDistance)
+				{
+					return maxDistance + 1;
+				}
+			}
+			return score <= maxDistance ? score : maxDistance + 1;
+		}
+
+		inline size_t LengthDifference(size_t left, size_t right)
+		{
+			return left > right ? left - right : right - left;
+		}
+
+		inline bool FuzzyMatchLess(const FuzzyMatch& left, const FuzzyMatch& right)
+		{
+			return left.Distance < right.Distance || (left.Distance == right.Distance && left.Index < right.Index);
+		}
+	}
+
+	inline size_t EditDistance(const String& a, const String& b, size_t maxDistance)
+	{
+		const String& pattern = a.Length() <= b.Length() ? a : b;
+		const String& text = a.Length() <= b.Length() ? b : a;
+		if (text.Length() - pattern.Length() > maxDistance)
+		{
+			return maxDistance + 1;
+		}
+		if (pattern.IsEmpty())
+		{
+			return text.Length();
+		}
+		if (pattern.Length() > fuzzy::WORDBITS)
+		{
+			return FuzzyMatcher(pattern).Distance(text, maxDistance);
+		}
+
+		// Single block: keep everything on the stack
+		uint64_t peq[256] = {};
+		const uint8_t* patternData = reinterpret_cast<const uint8_t*>(pattern.Data());
+		for (size_t index = 0; index < pattern.Length(); index++)
+		{
+			peq[patternData[index]] |= uint64_t(1) << index;
+		}
+		uint64_t pv = 0;
+		uint64_t mv = 0;
+		return fuzzy::BitParallelDistance(peq, 1, pattern.Length(), reinterpret_cast<const uint8_t*>(text.Data()), text.Length(), maxDistance, &pv, &mv);
+	}
+
+	inline FuzzyMatcher::FuzzyMatcher(const String& query) : m_Query(query), m_Blocks((query.Length() + fuzzy::WORDBITS - 1) / fuzzy::WORDBITS), m_Peq(), m_Pv(), m_Mv()
+	{
+		m_Peq.resize(256 * m_Blocks, 0);
+		m_Pv.resize(m_Blocks);
+		m_Mv.resize(m_Blocks);
+		const uint8_t* queryData = reinterpret_cast<const uint8_t*>(m_Query.ConstData());
+		for (size_t index = 0; index < m_Query.Length(); index++)
+		{
+			m_Peq[static_cast<size_t>(queryData[index]) * m_Blocks + index / fuzzy::WORDBITS] |= uint64_t(1) << (index % fuzzy::WORDBITS);
+		}
+	}
+
+	inline size_t FuzzyMatcher::Distance(const String& text, size_t maxDistance) const
+	{
+		if (fuzzy::LengthDifference(text.Length(), m_Query.Length()) > maxDistance)
+		{
+			return maxDistance + 1;
+		}
+		if (m_Query.IsEmpty())
+		{
+			return text.Length();
+		}
+		return fuzzy::BitParallelDistance(m_Peq.data(), m_Blocks, m_Query.Length(), reinterpret_cast<const uint8_t*>(text.Data()), text.Length(), maxDistance, m_Pv.data(), m_Mv.data());
+	}
+
+	inline void FuzzyMatcher::Search(const std::vector<String>& candidates, size_t k, size_t maxDistance, std::vector<FuzzyMatch>& out) const
+	{
+		out.clear();
+		if (k == 0)
+		{
+			return;
+		}
+
+		// out is kept as a max heap of the best k matches, its top sets the bound for all further candidates
+		size_t bound = maxDistance;
+		for (size_t index = 0; index < candidates.size(); index++)
+		{
+			const String& candidate = candidates[index];
+			if (fuzzy::LengthDifference(candidate.Length(), m_Query.Length()) > bound)
+			{
+				continue;
+			}
+			size_t distance = Distance(candidate, bound);
+			if (distance > bound)
+			{
+				continue;
+			}
+			out.push_back({ index, distance });
+			std::push_heap(out.begin(), out.end(), fuzzy::FuzzyMatchLess);
+			if (out.size() > k)
+			{
+				std::pop_heap(out.begin(), out.end(), fuzzy::FuzzyMatchLess);
+				out.pop_back();
+			}
+			if (out.size() == k)
+			{
+				// Later candidates only replace the top match by being strictly closer
+				if (out.front().Distance == 0)
+				{
+					break;
+				}
+				bound = min(bound, out.front().Distance - 1);
+			}
+		}
+		std::sort_heap(out.begin(), out.end(), fuzzy::FuzzyMatchLess);
+	}
+
+	inline void FuzzySearch(const std::vector<String>& candidates, const String& query, size_t k, size_t maxDistance, std::vector<FuzzyMatch>& out)
+	{
+		FuzzyMatcher(query).Search(candidates, k, maxDistance, out);
+	}
+}
\ No newline at end of file
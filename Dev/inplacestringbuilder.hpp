@@ -0,0 +1,83 @@
+#pragma once
+#include "string.hpp"
+
+namespace jht {
+
+	/// @brief What an InplaceStringBuilder does with input that exceeds its capacity
+	enum class InplaceOverflow : uint8_t
+	{
+		/// @brief Appends as much as fits and drops the rest
+		Truncate,
+		/// @brief Moves the content to a managed heap buffer and continues there
+		Spill,
+		/// @brief Rejects every append that does not fit completely
+		Fail
+	};
+
+	/// @brief StringBuilder with a fixed inline capacity, for short strings built on the stack without touching the heap
+	/// @details Offers the Append / operator<< surface of StringBuilder. Overflowed() reports whether the overflow policy had to act.
+	template<size_t N, InplaceOverflow TPolicy = InplaceOverflow::Truncate>
+	class InplaceStringBuilder
+	{
+		static_assert(N > 0, "InplaceStringBuilder needs a capacity");
+
+	private:
+		char m_Inline[N];
+		size_t m_Length;
+		String m_Spill;  // managed heap buffer once the content spilled, empty before
+		bool m_Overflowed;
+
+		char* Target() { return m_Spill.Length() ? m_Spill.Data() : m_Inline; }
+		bool MakeRoom(size_t& length);
+		template<typename TFormat>
+		void AppendFormatted(size_t maxLength, TFormat format);
+	public:
+		InplaceStringBuilder() : m_Length(0), m_Spill(), m_Overflowed(false) {}
+		/// @brief Copies the content. A spilled heap buffer is copied as well instead of being shared
+		InplaceStringBuilder(const InplaceStringBuilder& other);
+		InplaceStringBuilder& operator=(const InplaceStringBuilder& other);
+
+		/// @brief Length of the content
+		size_t Length() const { return m_Length; }
+		/// @brief Count of characters that fit without applying the overflow policy
+		size_t Capacity() const { return m_Spill.Length() ? m_Spill.Length() : N; }
+		/// @brief True if input was truncated, rejected or spilled to the heap
+		bool Overflowed() const { return m_Overflowed; }
+		/// @brief Removes the content. A spilled heap buffer is kept for reuse
+		void Clear() { m_Length = 0; m_Overflowed = false; }
+
+		/// @brief Append an integer, formatted in place
+		/// @param radius Which numeric system to use: 2 = binary, 8 = octal, 10 = decimal, 16 = hexadecimal
+		void AppendInt(int64_t value, int32_t radius = 10);
+		/// @brief Append an unsigned integer, formatted in place
+		/// @param radius Which numeric system to use: 2 = binary, 8 = octal, 10 = decimal, 16 = hexadecimal
+		void AppendUint(uint64_t value, int32_t radius = 10);
+		/// @brief Append a floating point value formatted like ToString, formatted in place
+		void AppendDouble(double value, int32_t precision = 10);
+		/// @brief Append the shortest decimal that parses back to exactly value, formatted in place
+		void AppendShortest(double value);
+		/// @brief Append the shortest decimal that parses back to exactly value as a float, formatted in place
+		void AppendShortest(float value);
+
+		/// @brief Append a string
+		void Append(const String& str);
+		/// @brief Append a null terminated string
+		void Append(const char* cstr) { Append(String::MakeView(cstr)); }
+		/// @brief Append a single character
+		void Append(char c);
+		/// @brief Append any value. Arithmetic values are formatted in place
+		template<typename T>
+		void Append(const T& value);
+		/// @brief Append any value. Followed by a newline
+		template<typename T>
+		void AppendLine(const T& value);
+		/// @brief Append any value
+		template<typename T>
+		InplaceStringBuilder& operator<<(const T& value);
+
+		/// @brief View of the content. Valid until the builder is modified or destroyed
+		String View() const { return String::MakeView(m_Spill.Length() ? m_Spill.ConstData() : m_Inline, m_Length); }
+		/// @brief Construct a managed string containing the content
+		String Build() const { return String::MakeManaged(m_Spill.Length() ? m_Spill.ConstData() : m_Inline, m_Length); }
+	};
+}
\ No newline at end of file
@@ -0,0 +1,172 @@
+#pragma once
+#include "inplacestringbuilder.hpp"
+#include "appendto.hpp"
+#include "stringbuilder.hpp"
+#include "tostring.hpp"
+#include <type_traits>
+
+namespace jht
+{
+	/// @brief Applies the overflow policy for an append of length characters
+	/// @param length is lowered to the count of characters that may be written
+	/// @return false if nothing may be written
+	template<size_t N, InplaceOverflow TPolicy>
+	inline bool InplaceStringBuilder<N, TPolicy>::MakeRoom(size_t& length)
+	{
+		size_t capacity = Capacity();
+		if (m_Length + length <= capacity) {
+			return true;
+		}
+		m_Overflowed = true;
+		if constexpr (TPolicy == InplaceOverflow::Spill)
+		{
+			String spill = String::MakeManaged(max(m_Length + length, capacity * 2));
+			memcpy(spill.Data(), Target(), m_Length);
+			m_Spill = spill;
+			return true;
+		}
+		else if constexpr (TPolicy == InplaceOverflow::Truncate)
+		{
+			length = capacity - m_Length;
+			return length > 0;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	template<size_t N, InplaceOverflow TPolicy>
+	inline InplaceStringBuilder<N, TPolicy>::InplaceStringBuilder(const InplaceStringBuilder& other) : m_Length(0), m_Spill(), m_Overflowed(false)
+	{
+		*this = other;
+	}
+
+	template<size_t N, InplaceOverflow TPolicy>
+	inline InplaceStringBuilder<N, TPolicy>& InplaceStringBuilder<N, TPolicy>::operator=(const InplaceStringBuilder& other)
+	{
+		if (this == &other) {
+			return *this;
+		}
+		// The spilled buffer is managed and would be shared by ref counting, so both builders would write into the same bytes
+		m_Spill = other.m_Spill.Length() ? other.m_Spill.MakeCopy() : String();
+		if (!m_Spill.Length()) {
+			memcpy(m_Inline, other.m_Inline, other.m_Length);
+		}
+		m_Length = other.m_Length;
+		m_Overflowed = other.m_Overflowed;
+		return *this;
+	}
+
+	template<size_t N, InplaceOverflow TPolicy>
+	template<typename TFormat>
+	inline void InplaceStringBuilder<N, TPolicy>::AppendFormatted(size_t maxLength, TFormat format)
+	{
+		if (m_Length + maxLength <= Capacity()) {
+			m_Length += format(Target() + m_Length);
+			return;
+		}
+		// Too close to the end to format in place, the policy then decides on the exact length
+		char scratch[max(tochars::MAXINTEGERLENGTH, tochars::MAXDOUBLELENGTH)];
+		Append(String::MakeView(scratch, format(scratch)));
+	}
+
+	template<size_t N, InplaceOverflow TPolicy>
+	inline void InplaceStringBuilder<N, TPolicy>::AppendInt(int64_t value, int32_t radius)
+	{
+		AppendFormatted(tochars::MaxIntegerLength(radius), [&](char* buffer) { return ToChars(buffer, value, radius); });
+	}
+
+	template<size_t N, InplaceOverflow TPolicy>
+	inline void InplaceStringBuilder<N, TPolicy>::AppendUint(uint64_t value, int32_t radius)
+	{
+		AppendFormatted(tochars::MaxIntegerLength(radius), [&](char* buffer) { return ToChars(buffer, value, radius); });
+	}
+
+	template<size_t N, InplaceOverflow TPolicy>
+	inline void InplaceStringBuilder<N, TPolicy>::AppendDouble(double value, int32_t precision)
+	{
+		AppendFormatted(tochars::MAXDOUBLELENGTH, [&](char* buffer) { return ToChars(buffer, value, precision); });
+	}
+
+	template<size_t N, InplaceOverflow TPolicy>
+	inline void InplaceStringBuilder<N, TPolicy>::AppendShortest(double value)
+	{
+		AppendFormatted(tochars::MAXSHORTESTLENGTH, [&](char* buffer) { return ToChars(buffer, value); });
+	}
+
+	template<size_t N, InplaceOverflow TPolicy>
+	inline void InplaceStringBuilder<N, TPolicy>::AppendShortest(float value)
+	{
+		AppendFormatted(tochars::MAXSHORTESTLENGTH, [&](char* buffer) { return ToChars(buffer, value); });
+	}
+
+	template<size_t N, InplaceOverflow TPolicy>
+	inline void InplaceStringBuilder<N, TPolicy>::Append(const String& str)
+	{
+		size_t length = str.Length();
+		if (MakeRoom(length)) {
+			memcpy(Target() + m_Length, str.ConstData(), length);
+			m_Length += length;
+		}
+	}
+
+	template<size_t N, InplaceOverflow TPolicy>
+	inline void InplaceStringBuilder<N, TPolicy>::Append(char c)
+	{
+		size_t length = 1;
+		if (MakeRoom(length)) {
+			Target()[m_Length] = c;
+			m_Length++;
+		}
+	}
+
+	template<size_t N, InplaceOverflow TPolicy>
+	template<typename T>
+	inline void InplaceStringBuilder<N, TPolicy>::Append(const T& value)
+	{
+		if constexpr ((std::is_array<T>::value || std::is_pointer<T>::value) && std::is_same<std::remove_cv_t<std::remove_pointer_t<std::decay_t<T>>>, char>::value)
+		{
+			// Char arrays and non-const char pointers are text, like const char*
+			Append(static_cast<const char*>(value));
+		}
+		else if constexpr (std::is_same<T, bool>::value)
+		{
+			Append(ToString(value));
+		}
+		else if constexpr (std::is_integral<T>::value)
+		{
+			AppendFormatted(tochars::MAXDECIMALLENGTH<T>, [&](char* buffer) { return ToChars(buffer, value); });
+		}
+		else if constexpr (std::is_floating_point<T>::value)
+		{
+			AppendDouble(static_cast<double>(value));
+		}
+		else if constexpr (appendto::HasAppendTo<T>::value)
+		{
+			StringBuilder builder;
+			AppendTo(builder, value);
+			Append(builder.Build());
+		}
+		else
+		{
+			Append(ToString(value));
+		}
+	}
+
+	template<size_t N, InplaceOverflow TPolicy>
+	template<typename T>
+	inline void InplaceStringBuilder<N, TPolicy>::AppendLine(const T& value)
+	{
+		Append(value);
+		Append('\n');
+	}
+
+	template<size_t N, InplaceOverflow TPolicy>
+	template<typename T>
+	inline InplaceStringBuilder<N, TPolicy>& InplaceStringBuilder<N, TPolicy>::operator<<(const T& value)
+	{
+		Append(value);
+		return *this;
+	}
+}
\ No newline at end of file
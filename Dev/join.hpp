@@ -0,0 +1,36 @@
+#pragma once
+#include "string.hpp"
+
+namespace jht {
+
+	namespace join
+	{
+		/// @brief Result length from which Join copies on multiple threads
+		const size_t PARALLELTHRESHOLD = 8 * 1024 * 1024;
+		/// @brief Minimum count of bytes each copying thread gets
+		const size_t MINBYTESPERTHREAD = 1024 * 1024;
+
+		/// @brief Default projection of Join, passing the elements through
+		struct Identity
+		{
+			template<typename T>
+			const T& operator()(const T& value) const { return value; }
+		};
+	}
+
+	/// @brief Concatenates all Strings of range, separated by separator
+	/// @details The result length is computed up front, so it is allocated once and every piece is copied by a single memcpy.
+	/// Results of at least join::PARALLELTHRESHOLD bytes are copied on multiple threads if range has random access iterators.
+	/// @param range any range of Strings, e.g. the output of String::Split
+	/// @param threadCount maximum count of copying threads, 0 for the hardware concurrency
+	/// @return a managed String, or an empty String for an empty range
+	template<typename TRange>
+	String Join(const TRange& range, const String& separator, size_t threadCount = 0);
+
+	/// @brief Concatenates project(element) for all elements of range, separated by separator. See Join
+	/// @details Used to join a column of a table, e.g. JoinBy(rows, ",", [](const Row& row) -> const String& { return row.Name; })
+	/// @param project returns a String or a const reference to one per element. Called twice per element. Only projections returning
+	/// references are called from multiple threads for large results, by value projections always run on the calling thread
+	template<typename TRange, typename TProject>
+	String JoinBy(const TRange& range, const String& separator, TProject project, size_t threadCount = 0);
+}
\ No newline at end of file
@@ -0,0 +1,126 @@
+#pragma once
+#include "join.hpp"
+#include <iterator>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jht
+{
+	namespace join
+	{
+		/// @brief Copies the elements [begin, end) and the separators in front of them to output
+		/// @param first true if begin is the first element of the whole range, which gets no separator
+		template<typename TIterator, typename TProject>
+		inline void CopyPieces(TIterator begin, TIterator end, const String& separator, TProject& project, char* output, bool first)
+		{
+			const char* separatorData = separator.ConstData();
+			size_t separatorLength = separator.Length();
+			for (TIterator iter = begin; iter != end; ++iter)
+			{
+				if (!first) {
+					memcpy(output, separatorData, separatorLength);
+					output += separatorLength;
+				}
+				first = false;
+				const auto& piece = project(*iter);
+				memcpy(output, piece.ConstData(), piece.Length());
+				output += piece.Length();
+			}
+		}
+	}
+
+	template<typename TRange>
+	inline String Join(const TRange& range, const String& separator, size_t threadCount)
+	{
+		return JoinBy(range, separator, join::Identity(), threadCount);
+	}
+
+	template<typename TRange, typename TProject>
+	inline String JoinBy(const TRange& range, const String& separator, TProject project, size_t threadCount)
+	{
+		using TIterator = decltype(std::begin(range));
+		constexpr bool RANDOMACCESS = std::is_base_of<std::random_access_iterator_tag, typename std::iterator_traits<TIterator>::iterator_category>::value;
+		// Pieces returned by value are copies, and copying a managed String changes its (non atomic) ref count. Only pieces
+		// referenced in place can be read from several threads, by value projections are copied on the calling thread
+		constexpr bool PARALLEL = RANDOMACCESS && std::is_reference<decltype(*std::declval<TIterator>())>::value
+			&& std::is_reference<decltype(project(*std::declval<TIterator>()))>::value;
+
+		auto begin = std::begin(range);
+		auto end = std::end(range);
+		if (begin == end) {
+			return String();
+		}
+		if (threadCount == 0) {
+			threadCount = max(size_t(std::thread::hardware_concurrency()), size_t(1));
+		}
+
+		// Measure the pieces. If copying in parallel is possible the offsets of the chunks each thread would copy are recorded on the way
+		size_t count = 0;
+		size_t length = 0;
+		size_t chunkSize = SIZE_MAX;
+		std::vector<size_t> chunkOffsets;
+		if constexpr (PARALLEL) {
+			size_t elements = static_cast<size_t>(end - begin);
+			threadCount = min(threadCount, elements);
+			chunkSize = (elements + threadCount - 1) / threadCount;
+		}
+		for (auto iter = begin; iter != end; ++iter)
+		{
+			if (count % chunkSize == 0) {
+				// A chunk starts with the separator in front of its first element
+				chunkOffsets.push_back(length + (count ? count - 1 : 0) * separator.Length());
+			}
+			length += project(*iter).Length();
+			count++;
+		}
+		length += (count - 1) * separator.Length();
+
+		String result = String::MakeManaged(length);
+		if (length == 0) {
+			return result;
+		}
+		char* output = result.Data();
+		threadCount = min(threadCount, max(length / join::MINBYTESPERTHREAD, size_t(1)));
+		if constexpr (PARALLEL) {
+			if (length >= join::PARALLELTHRESHOLD && threadCount > 1) {
+				// Threads copy whole groups of recorded chunks, the calling thread takes the first group
+				size_t chunks = chunkOffsets.size();
+				size_t groupSize = (chunks + threadCount - 1) / threadCount;
+				std::vector<std::thread> threads;
+				threads.reserve(threadCount);
+				size_t unassigned = groupSize;  // first chunk no thread took
+				try
+				{
+					for (size_t group = groupSize; group < chunks; group += groupSize)
+					{
+						size_t first = group * chunkSize;
+						size_t last = min(count, (group + groupSize) * chunkSize);
+						threads.emplace_back([&, first, last, group]()
+						{
+							join::CopyPieces(begin + first, begin + last, separator, project, output + chunkOffsets[group], false);
+						});
+						unassigned = group + groupSize;
+					}
+				}
+				catch (const std::system_error&)
+				{
+					// Out of threads: the calling thread copies the groups that were not started, the started ones are still joined
+				}
+				join::CopyPieces(begin, begin + min(count, groupSize * chunkSize), separator, project, output, true);
+				if (unassigned < chunks) {
+					join::CopyPieces(begin + unassigned * chunkSize, end, separator, project, output + chunkOffsets[unassigned], false);
+				}
+				for (std::thread& thread : threads)
+				{
+					thread.join();
+				}
+				return result;
+			}
+		}
+		join::CopyPieces(begin, end, separator, project, output, true);
+		return result;
+	}
+}
\ No newline at end of file
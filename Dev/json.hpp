@@ -0,0 +1,24 @@
+#pragma once
+#include "string.hpp"
+
+namespace jht {
+
+	namespace json
+	{
+		/// @brief Finds the first character of data that has to be escaped in a JSON string: quote, backslash or a control character
+		/// @return its index, or length if there is none
+		inline size_t FindEscapeCharacter(const char* data, size_t length);
+		/// @brief Finds the first backslash of data
+		/// @return its index, or length if there is none
+		inline size_t FindBackslash(const char* data, size_t length);
+	}
+
+	/// @brief Resolves the escape sequences of the content of a JSON string (without the enclosing quotes)
+	/// @details Input without any backslash is returned as is, without copying. Malformed escape sequences are kept verbatim
+	inline String JsonUnescape(const String& value);
+	/// @brief Resolves the escape sequences of the content of a JSON string (without the enclosing quotes)
+	/// @details Input without any backslash is returned as is, without copying
+	/// @param out receives the unescaped value, or value itself if unescaping fails
+	/// @return false if value contains a malformed escape sequence
+	inline bool TryJsonUnescape(const String& value, String& out);
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+#pragma once
+#include "json.hpp"
+#include "stringbuilder.hpp"
+#include <bit>
+
+namespace jht
+{
+	namespace json
+	{
+		inline size_t FindEscapeCharacter(const char* data, size_t length)
+		{
+			size_t index = 0;
+#ifdef JHT_STRING_SSE2
+			const __m128i quote = _mm_set1_epi8('"');
+			const __m128i backslash = _mm_set1_epi8('\\');
+			const __m128i control = _mm_set1_epi8(0x1F);
+			for (; index + 16 <= length; index += 16)
+			{
+				__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+				// Unsigned chunk <= 0x1F holds where max(chunk, 0x1F) stays 0x1F
+				__m128i special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(chunk, quote), _mm_cmpeq_epi8(chunk, backslash)),
+					_mm_cmpeq_epi8(_mm_max_epu8(chunk, control), control));
+				uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(special));
+				if (mask) {
+					return index + std::countr_zero(mask);
+				}
+			}
+#endif
+			for (; index < length; index++)
+			{
+				uint8_t c = static_cast<uint8_t>(data[index]);
+				if (c == '"' || c == '\\' || c < 0x20) {
+					return index;
+				}
+			}
+			return length;
+		}
+
+		inline size_t FindBackslash(const char* data, size_t length)
+		{
+			size_t index = 0;
+#ifdef JHT_STRING_SSE2
+			const __m128i backslash = _mm_set1_epi8('\\');
+			for (; index + 16 <= length; index += 16)
+			{
+				uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index)), backslash)));
+				if (mask) {
+					return index + std::countr_zero(mask);
+				}
+			}
+#endif
+			for (; index < length; index++)
+			{
+				if (data[index] == '\\') {
+					return index;
+				}
+			}
+			return length;
+		}
+
+		/// @brief Reads 4 hexadecimal digits
+		/// @return false if data does not start with 4 hexadecimal digits
+		inline bool ReadHex4(const char* data, char32_t& out)
+		{
+			out = 0;
+			for (size_t index = 0; index < 4; index++)
+			{
+				char c = data[index];
+				uint32_t digit = 0;
+				if (c >= '0' && c <= '9') {
+					digit = c - '0';
+				}
+				else if (c >= 'a' && c <= 'f') {
+					digit = c - 'a' + 10;
+				}
+				else if (c >= 'A' && c <= 'F') {
+					digit = c - 'A' + 10;
+				}
+				else {
+					return false;
+				}
+				out = (out << 4) | digit;
+			}
+			return true;
+		}
+
+		/// @brief Decodes the escape sequence at data[0] (a backslash) to output
+		/// @param consumed receives the length of the escape sequence
+		/// @return count of bytes written, 0 if the sequence is malformed
+		inline size_t UnescapeSequence(const char* data, size_t length, char* output, size_t& consumed)
+		{
+			consumed = 2;
+			if (length < 2) {
+				return 0;
+			}
+			switch (data[1])
+			{
+			case '"': output[0] = '"'; return 1;
+			case '\\': output[0] = '\\'; return 1;
+			case '/': output[0] = '/'; return 1;
+			case 'b': output[0] = '\b'; return 1;
+			case 'f': output[0] = '\f'; return 1;
+			case 'n': output[0] = '\n'; return 1;
+			case 'r': output[0] = '\r'; return 1;
+			case 't': output[0] = '\t'; return 1;
+			case 'u':
+			{
+				char32_t code = 0;
+				if (length < 6 || !ReadHex4(data + 2, code)) {
+					return 0;
+				}
+				consumed = 6;
+				char32_t low = 0;
+				if ((code & 0xFC00) == 0xD800 && length >= 12 && data[6] == '\\' && data[7] == 'u' && ReadHex4(data + 8, low) && (low & 0xFC00) == 0xDC00) {
+					code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+					consumed = 12;
+				}
+				return stringbuilder::EncodeUtf8(output, code);
+			}
+			default:
+				return 0;
+			}
+		}
+
+		/// @brief Shared implementation of JsonUnescape and TryJsonUnescape
+		inline bool Unescape(const String& value, String& out)
+		{
+			const char* data = value.ConstData();
+			size_t length = value.Length();
+			size_t index = FindBackslash(data, length);
+			if (index == length) {
+				out = value;
+				return true;
+			}
+
+			// Unescaping never lengthens the text, so the output is written into a single buffer which Build() hands over
+			bool valid = true;
+			StringBuilder builder;
+			builder.Reserve(length);
+			char* output = builder.AcquireWrite(length);
+			size_t written = 0;
+			size_t start = 0;
+			while (index < length)
+			{
+				memcpy(output + written, data + start, index - start);
+				written += index - start;
+				size_t consumed = 0;
+				size_t decoded = UnescapeSequence(data + index, length - index, output + written, consumed);
+				if (decoded == 0) {
+					valid = false;
+					consumed = min(consumed, length - index);
+					memcpy(output + written, data + index, consumed);
+					decoded = consumed;
+				}
+				written += decoded;
+				start = index + consumed;
+				index = start + FindBackslash(data + start, length - start);
+			}
+			memcpy(output + written, data + start, length - start);
+			builder.CommitWrite(written + length - start);
+			out = builder.Build();
+			return valid;
+		}
+	}
+
+	inline String JsonUnescape(const String& value)
+	{
+		String out;
+		json::Unescape(value, out);
+		return out;
+	}
+
+	inline bool TryJsonUnescape(const String& value, String& out)
+	{
+		if (!json::Unescape(value, out)) {
+			out = value;
+			return false;
+		}
+		return true;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+#include <vector>
+#include "string.hpp"
+
+namespace jht {
+
+	/// @brief Maps between byte offsets and (line, column) positions of a text. Lines and columns are zero based, columns count bytes
+	/// @details The text is scanned for '\n' once (16 bytes at a time where SSE2 is available) and the start offset of every line is stored.
+	/// Lines are separated by '\n', a '\r' before it is not part of the line. A text ending with '\n' ends with an empty line.
+	class LineIndex
+	{
+	private:
+		String m_Text;
+		std::vector<size_t> m_LineStarts;
+
+		void Scan(size_t from);
+
+	public:
+		/// @brief Creates an index of an empty text
+		LineIndex() : m_Text(), m_LineStarts(1, 0) {}
+		/// @brief Creates an index of text
+		LineIndex(const String& text);
+
+		/// @brief Replaces the indexed text
+		void Build(const String& text);
+		/// @brief Replaces the indexed text by a longer one starting with the current text, only the appended part is scanned
+		void Extend(const String& text);
+
+		/// @brief The indexed text
+		const String& Text() const { return m_Text; }
+		/// @brief Count of lines, at least 1
+		size_t LineCount() const { return m_LineStarts.size(); }
+		/// @brief Offset of the first byte of a line
+		size_t LineStart(size_t line) const;
+		/// @brief Returns a view of a line, without its line terminator
+		String Line(size_t line) const;
+		/// @brief Finds the position of an offset in O(log n)
+		/// @param offset byte offset, up to and including Text().Length()
+		void Position(size_t offset, size_t& line, size_t& column) const;
+	};
+}
\ No newline at end of file
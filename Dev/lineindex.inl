@@ -0,0 +1,86 @@
+#pragma once
+#include "lineindex.hpp"
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+namespace jht
+{
+	inline LineIndex::LineIndex(const String& text) : m_Text(), m_LineStarts()
+	{
+		Build(text);
+	}
+
+	inline void LineIndex::Scan(size_t from)
+	{
+		const char* data = m_Text.ConstData();
+		size_t length = m_Text.Length();
+		size_t index = from;
+#ifdef JHT_STRING_SSE2
+		const __m128i newline = _mm_set1_epi8('\n');
+		for (; index + 16 <= length; index += 16)
+		{
+			uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index)), newline)));
+			while (mask)
+			{
+				m_LineStarts.push_back(index + std::countr_zero(mask) + 1);
+				mask &= mask - 1;
+			}
+		}
+#endif
+		for (; index < length; index++)
+		{
+			if (data[index] == '\n')
+			{
+				m_LineStarts.push_back(index + 1);
+			}
+		}
+	}
+
+	inline void LineIndex::Build(const String& text)
+	{
+		m_Text = text;
+		m_LineStarts.clear();
+		m_LineStarts.push_back(0);
+		Scan(0);
+	}
+
+	inline void LineIndex::Extend(const String& text)
+	{
+		size_t scanned = m_Text.Length();
+#ifndef JHT_STRING_NOASSERT
+		assert(text.Length() >= scanned && memcmp(text.ConstData(), m_Text.ConstData(), scanned) == 0 && "Text has to start with the indexed text!");
+#endif
+		m_Text = text;
+		Scan(scanned);
+	}
+
+	inline size_t LineIndex::LineStart(size_t line) const
+	{
+#ifndef JHT_STRING_NOASSERT
+		assert(line < m_LineStarts.size() && "Line invalid!");
+#endif
+		return m_LineStarts[line];
+	}
+
+	inline String LineIndex::Line(size_t line) const
+	{
+		size_t start = LineStart(line);
+		size_t end = line + 1 < m_LineStarts.size() ? m_LineStarts[line + 1] - 1 : m_Text.Length();
+		const char* data = m_Text.ConstData();
+		if (end > start && data[end - 1] == '\r')
+		{
+			end--;
+		}
+		return String(data + start, end - start);
+	}
+
+	inline void LineIndex::Position(size_t offset, size_t& line, size_t& column) const
+	{
+#ifndef JHT_STRING_NOASSERT
+		assert(offset <= m_Text.Length() && "Offset invalid!");
+#endif
+		line = static_cast<size_t>(std::upper_bound(m_LineStarts.begin(), m_LineStarts.end(), offset) - m_LineStarts.begin()) - 1;
+		column = offset - m_LineStarts[line];
+	}
+}
\ No newline at end of file
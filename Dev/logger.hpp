@@ -0,0 +1,117 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+#include "stringbuilder.hpp"
+
+namespace jht {
+
+	/// @brief Severity of a log record
+	enum class LogLevel : uint8_t
+	{
+		Trace,
+		Debug,
+		Info,
+		Warning,
+		Error
+	};
+
+	/// @brief Asynchronous logger writing to a file descriptor
+	/// @details Records are formatted on the calling thread into a thread local StringBuilder (numbers are formatted in place) and copied
+	/// into a single allocation, which is pushed onto a lock-free multi producer queue. A background thread collects the queued records
+	/// and writes them in batches with writev. Callers never block on I/O or on each other.
+	class Logger
+	{
+	private:
+		struct Record
+		{
+			std::atomic<Record*> Next;
+			size_t Length;
+			char Text[1];
+		};
+
+		int m_File;
+		std::atomic<LogLevel> m_MinLevel;
+		std::atomic<Record*> m_Head;  // most recently pushed record, written by producers
+		Record* m_Tail;               // oldest record, owned by the writer thread
+		Record m_Stub;
+		std::atomic<size_t> m_Pushed;
+		std::atomic<size_t> m_Written;
+		std::atomic<size_t> m_Dropped;
+		std::atomic<bool> m_Stopping;
+		std::atomic<bool> m_Failed;
+		std::chrono::microseconds m_Interval;
+		std::thread m_Writer;
+
+		/// @brief Builder a record is formatted in: the thread local one, or a separate one while the thread local one is busy
+		/// @details Logging from inside an AppendTo overload of a value being logged starts a record while the outer one is formatted
+		class FormatScope
+		{
+		private:
+			StringBuilder* m_Builder;
+			std::optional<StringBuilder> m_Nested;
+		public:
+			FormatScope();
+			~FormatScope();
+			FormatScope(const FormatScope&) = delete;
+			FormatScope& operator=(const FormatScope&) = delete;
+			StringBuilder& Get() { return *m_Builder; }
+		};
+
+		static constexpr size_t FORMATBUFFERSIZE = 1024;
+		static constexpr size_t FORMATTHRESHOLD = 256;
+
+		static StringBuilder& Builder();
+		static bool& BuilderInUse();
+		static const String& LevelName(LogLevel level);
+
+		template<typename TValue, typename... TFields>
+		static void AppendFields(StringBuilder& builder, const String& key, const TValue& value, const TFields&... fields);
+		static void AppendFields(StringBuilder&) {}
+
+		void Push(Record* record);
+		Record* Pop();
+		void Submit(StringBuilder& builder);
+		void WriteLoop();
+		size_t WriteAvailable();
+
+	public:
+		/// @brief Default time the writer thread sleeps when the queue is empty
+		static constexpr std::chrono::microseconds DEFAULTINTERVAL = std::chrono::microseconds(500);
+		/// @brief Count of records the writer thread passes to one writev call
+		static const size_t BATCHSIZE = 64;
+
+		/// @param file descriptor the records are written to. It is not closed by the logger
+		/// @param minLevel records below this level are discarded without being formatted
+		/// @param interval time the writer thread sleeps when the queue is empty. Bounds the delay until a record is written
+		Logger(int file, LogLevel minLevel = LogLevel::Info, std::chrono::microseconds interval = DEFAULTINTERVAL);
+		/// @brief Writes all pending records and stops the writer thread
+		~Logger();
+		Logger(const Logger&) = delete;
+		Logger& operator=(const Logger&) = delete;
+
+		/// @brief True if records of level are logged
+		bool IsEnabled(LogLevel level) const { return level >= m_MinLevel.load(std::memory_order_relaxed); }
+		/// @brief Changes the minimum level of logged records
+		void SetMinLevel(LogLevel level) { m_MinLevel.store(level, std::memory_order_relaxed); }
+
+		/// @brief Logs a record made of the level name followed by all values appended like StringBuilder::operator<< does, ended by a newline
+		/// @details Pass Strings that are reused (keys, fixed messages) as static const String instances to avoid measuring their length each call.
+		/// May be called from inside an AppendTo overload of a logged value, the nested record is then formatted in a separate builder
+		template<typename... TValues>
+		void Log(LogLevel level, const TValues&... values);
+		/// @brief Logs a structured record: "LEVEL message key=value key=value..." ended by a newline
+		/// @param fields alternating keys (Strings) and values
+		template<typename... TFields>
+		void LogFields(LogLevel level, const String& message, const TFields&... fields);
+
+		/// @brief Blocks until every record logged before the call is written
+		/// @return false if any write failed so far
+		bool Flush();
+		/// @brief Count of records written so far
+		size_t WrittenCount() const { return m_Written.load(std::memory_order_acquire); }
+		/// @brief Count of records discarded because their memory could not be allocated
+		size_t DroppedCount() const { return m_Dropped.load(std::memory_order_relaxed); }
+	};
+}
\ No newline at end of file
@@ -0,0 +1,232 @@
+#pragma once
+#include "logger.hpp"
+#include <cstdlib>
+#include <new>
+#ifndef _WIN32
+#include <sys/uio.h>
+#endif
+
+namespace jht
+{
+#pragma region Formatting
+
+	inline StringBuilder& Logger::Builder()
+	{
+		// Large enough to stage whole records, so finishing one is a single copy out of the staging buffer
+		static thread_local StringBuilder builder(FORMATBUFFERSIZE, FORMATTHRESHOLD);
+		return builder;
+	}
+
+	inline bool& Logger::BuilderInUse()
+	{
+		static thread_local bool inUse = false;
+		return inUse;
+	}
+
+	inline Logger::FormatScope::FormatScope() : m_Builder(nullptr), m_Nested()
+	{
+		if (BuilderInUse()) {
+			m_Nested.emplace(FORMATBUFFERSIZE, FORMATTHRESHOLD);
+			m_Builder = &*m_Nested;
+			return;
+		}
+		BuilderInUse() = true;
+		m_Builder = &Builder();
+	}
+
+	inline Logger::FormatScope::~FormatScope()
+	{
+		if (!m_Nested) {
+			// Also discards a record left unfinished by an exception from AppendTo
+			m_Builder->Clear();
+			BuilderInUse() = false;
+		}
+	}
+
+	inline const String& Logger::LevelName(LogLevel level)
+	{
+		static const String NAMES[] = { "TRACE ", "DEBUG ", "INFO  ", "WARN  ", "ERROR " };
+		return NAMES[static_cast<size_t>(level)];
+	}
+
+	template<typename TValue, typename... TFields>
+	inline void Logger::AppendFields(StringBuilder& builder, const String& key, const TValue& value, const TFields&... fields)
+	{
+		builder << ' ' << key << '=' << value;
+		AppendFields(builder, fields...);
+	}
+
+	template<typename... TValues>
+	inline void Logger::Log(LogLevel level, const TValues&... values)
+	{
+		if (!IsEnabled(level)) {
+			return;
+		}
+		FormatScope scope;
+		StringBuilder& builder = scope.Get();
+		builder << LevelName(level);
+		(builder << ... << values);
+		builder << '\n';
+		Submit(builder);
+	}
+
+	template<typename... TFields>
+	inline void Logger::LogFields(LogLevel level, const String& message, const TFields&... fields)
+	{
+		static_assert(sizeof...(TFields) % 2 == 0, "LogFields expects pairs of keys and values");
+		if (!IsEnabled(level)) {
+			return;
+		}
+		FormatScope scope;
+		StringBuilder& builder = scope.Get();
+		builder << LevelName(level) << message;
+		AppendFields(builder, fields...);
+		builder << '\n';
+		Submit(builder);
+	}
+
+	inline void Logger::Submit(StringBuilder& builder)
+	{
+		size_t length = builder.Length();
+		void* memory = std::malloc(sizeof(Record) + length);
+		if (!memory) {
+			// Logging must not fail the caller, the record is counted and discarded
+			builder.Clear();
+			m_Dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+		Record* record = new (memory) Record();
+		record->Length = length;
+		builder.CopyTo(record->Text);
+		builder.Clear();
+		m_Pushed.fetch_add(1, std::memory_order_relaxed);
+		Push(record);
+	}
+
+#pragma endregion
+#pragma region Queue
+
+	// Intrusive multi producer single consumer queue (D. Vyukov). Producers only exchange the head, the writer thread owns the tail.
+	// The stub record keeps the queue non-empty, so the head never has to be reset
+
+	inline void Logger::Push(Record* record)
+	{
+		record->Next.store(nullptr, std::memory_order_relaxed);
+		Record* previous = m_Head.exchange(record, std::memory_order_acq_rel);
+		previous->Next.store(record, std::memory_order_release);
+	}
+
+	inline Logger::Record* Logger::Pop()
+	{
+		Record* tail = m_Tail;
+		Record* next = tail->Next.load(std::memory_order_acquire);
+		if (tail == &m_Stub) {
+			if (!next) {
+				return nullptr;
+			}
+			m_Tail = next;
+			tail = next;
+			next = next->Next.load(std::memory_order_acquire);
+		}
+		if (next) {
+			m_Tail = next;
+			return tail;
+		}
+		if (tail != m_Head.load(std::memory_order_acquire)) {
+			// A producer exchanged the head but did not link its record yet
+			return nullptr;
+		}
+		Push(&m_Stub);
+		next = tail->Next.load(std::memory_order_acquire);
+		if (next) {
+			m_Tail = next;
+			return tail;
+		}
+		return nullptr;
+	}
+
+#pragma endregion
+#pragma region Writing
+
+	inline Logger::Logger(int file, LogLevel minLevel, std::chrono::microseconds interval)
+		: m_File(file), m_MinLevel(minLevel), m_Head(&m_Stub), m_Tail(&m_Stub), m_Stub(), m_Pushed(0), m_Written(0), m_Dropped(0), m_Stopping(false), m_Failed(false),
+		m_Interval(interval), m_Writer()
+	{
+		m_Stub.Next.store(nullptr, std::memory_order_relaxed);
+		m_Stub.Length = 0;
+		m_Writer = std::thread(&Logger::WriteLoop, this);
+	}
+
+	inline Logger::~Logger()
+	{
+		m_Stopping.store(true, std::memory_order_release);
+		m_Writer.join();
+		while (WriteAvailable() > 0)
+		{
+		}
+	}
+
+	inline size_t Logger::WriteAvailable()
+	{
+		Record* batch[BATCHSIZE];
+		size_t count = 0;
+		while (count < BATCHSIZE && (batch[count] = Pop()) != nullptr)
+		{
+			count++;
+		}
+		if (count == 0) {
+			return 0;
+		}
+
+		bool written = true;
+#ifdef _WIN32
+		for (size_t index = 0; index < count && written; index++)
+		{
+			written = stringbuilder::WriteAll(m_File, batch[index]->Text, batch[index]->Length);
+		}
+#else
+		iovec vectors[BATCHSIZE];
+		for (size_t index = 0; index < count; index++)
+		{
+			vectors[index].iov_base = batch[index]->Text;
+			vectors[index].iov_len = batch[index]->Length;
+		}
+		written = stringbuilder::WriteAll(m_File, vectors, count);
+#endif
+		if (!written) {
+			m_Failed.store(true, std::memory_order_relaxed);
+		}
+		for (size_t index = 0; index < count; index++)
+		{
+			std::free(batch[index]);
+		}
+		m_Written.fetch_add(count, std::memory_order_release);
+		return count;
+	}
+
+	inline void Logger::WriteLoop()
+	{
+		while (true)
+		{
+			bool stopping = m_Stopping.load(std::memory_order_acquire);
+			if (WriteAvailable() == 0) {
+				if (stopping) {
+					return;
+				}
+				std::this_thread::sleep_for(m_Interval);
+			}
+		}
+	}
+
+	inline bool Logger::Flush()
+	{
+		size_t target = m_Pushed.load(std::memory_order_relaxed);
+		while (m_Written.load(std::memory_order_acquire) < target)
+		{
+			std::this_thread::sleep_for(m_Interval / 4);
+		}
+		return !m_Failed.load(std::memory_order_relaxed);
+	}
+
+#pragma endregion
+}
\ No newline at end of file
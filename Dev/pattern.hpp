@@ -0,0 +1,92 @@
+#pragma once
+#include <vector>
+#include <map>
+#include <bitset>
+#include "string.hpp"
+
+namespace jht {
+
+	namespace pattern
+	{
+		enum class NfaType : uint8_t
+		{
+			Char,
+			Split,
+			Epsilon,
+			AssertBegin,
+			AssertEnd,
+			Match
+		};
+
+		struct NfaState
+		{
+			NfaType Type;
+			int32_t Out;
+			int32_t Out1;
+			std::bitset<256> Chars;
+
+			NfaState(NfaType type) : Type(type), Out(-1), Out1(-1), Chars() {}
+		};
+
+		struct DfaState
+		{
+			std::vector<int32_t> NfaStates;
+			bool Accepting;
+			bool AcceptingAtEnd;
+		};
+
+		class Compiler;
+	}
+
+	/// @brief A compiled glob or regular expression subset, matched by a lazily built DFA without backtracking
+	/// @details Regex syntax: literals, escapes (\\d \\w \\s \\D \\W \\S \\n \\t \\r and escaped metacharacters), '.', classes ([abc], [a-z], [^abc]),
+	/// groups, alternation '|', the quantifiers '*', '+', '?' (not stacked, so no lazy or possessive forms) and the anchors '^' and '$'. A regex matches anywhere in the text unless anchored.
+	/// Glob syntax: '*', '?', classes ([abc], [!abc]), alternation ({a,b}) and '\\' escapes. A glob has to match the whole text.
+	/// DFA states are discovered on first use and cached, so matching only allocates until the cache is warm.
+	/// Matching mutates that cache, so a single instance must not be used by multiple threads at once (copy it instead).
+	class Pattern
+	{
+	private:
+		static const size_t MAXDFASTATES = 2048;
+		static const int32_t STATE_BEGIN = 0;
+		static const int32_t STATE_DEAD = 1;
+		static const int32_t STATE_RESTART = 2;
+
+		std::vector<pattern::NfaState> m_Nfa;
+		int32_t m_Start;
+		bool m_Search;
+		int32_t m_PrefilterByte;
+
+		mutable std::vector<pattern::DfaState> m_Dfa;
+		mutable std::vector<int32_t> m_Transitions;
+		mutable std::map<std::vector<int32_t>, int32_t> m_DfaLookup;
+		mutable std::vector<uint32_t> m_Marks;
+		mutable uint32_t m_Generation;
+		mutable std::vector<int32_t> m_Stack;
+		mutable std::vector<int32_t> m_Scratch;
+
+		void Closure(std::vector<int32_t>& out, int32_t state, bool atBegin, bool atEnd) const;
+		int32_t AddDfaState(std::vector<int32_t>& nfaStates, bool isBegin) const;
+		int32_t ComputeTransition(int32_t state, uint8_t character) const;
+		void ResetCache() const;
+		void Finalize();
+
+		friend class pattern::Compiler;
+	public:
+		Pattern() : m_Nfa(), m_Start(-1), m_Search(false), m_PrefilterByte(-1), m_Dfa(), m_Transitions(), m_DfaLookup(), m_Marks(), m_Generation(0), m_Stack(), m_Scratch() {}
+
+		/// @brief Compiles a regular expression (see class description for the supported subset)
+		/// @param out compiled pattern. Left invalid if compilation fails
+		/// @return true if the source is a valid expression
+		static bool TryCompileRegex(const String& source, Pattern& out);
+		/// @brief Compiles a glob pattern (see class description for the supported syntax)
+		/// @param out compiled pattern. Left invalid if compilation fails
+		/// @return true if the source is a valid glob
+		static bool TryCompileGlob(const String& source, Pattern& out);
+
+		/// @brief True if this instance holds a successfully compiled pattern
+		bool IsValid() const;
+		/// @brief Tests text against the pattern. Globs have to match the whole text, regular expressions match anywhere unless anchored
+		bool Matches(const String& text) const;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,720 @@
+#pragma once
+#include "pattern.hpp"
+#include <cassert>
+#include <algorithm>
+
+namespace jht
+{
+	namespace pattern
+	{
+		/// @brief Thompson construction of the NFA from either regex or glob syntax
+		class Compiler
+		{
+		private:
+			struct Fragment
+			{
+				int32_t Start;
+				std::vector<std::pair<int32_t, bool>> Dangling; // (state, patch Out1 instead of Out)
+			};
+
+			std::vector<NfaState>& m_Nfa;
+			const char* m_Cur;
+			const char* m_End;
+
+			int32_t NewState(NfaType type, int32_t out = -1, int32_t out1 = -1)
+			{
+				m_Nfa.push_back(NfaState(type));
+				m_Nfa.back().Out = out;
+				m_Nfa.back().Out1 = out1;
+				return static_cast<int32_t>(m_Nfa.size() - 1);
+			}
+
+			Fragment Single(int32_t state)
+			{
+				Fragment frag;
+				frag.Start = state;
+				frag.Dangling.push_back({ state, false });
+				return frag;
+			}
+
+			void Patch(const Fragment& frag, int32_t target)
+			{
+				for (const std::pair<int32_t, bool>& dangling : frag.Dangling)
+				{
+					if (dangling.second)
+					{
+						m_Nfa[dangling.first].Out1 = target;
+					}
+					else
+					{
+						m_Nfa[dangling.first].Out = target;
+					}
+				}
+			}
+
+			void Chain(Fragment& left, Fragment& right)
+			{
+				Patch(left, right.Start);
+				left.Dangling = std::move(right.Dangling);
+			}
+
+			Fragment Alternate(Fragment& left, Fragment& right)
+			{
+				Fragment frag;
+				frag.Start = NewState(NfaType::Split, left.Start, right.Start);
+				frag.Dangling = std::move(left.Dangling);
+				frag.Dangling.insert(frag.Dangling.end(), right.Dangling.begin(), right.Dangling.end());
+				return frag;
+			}
+
+			Fragment Literal(char c)
+			{
+				int32_t state = NewState(NfaType::Char);
+				m_Nfa[state].Chars.set(static_cast<uint8_t>(c));
+				return Single(state);
+			}
+
+			Fragment AnyChar(bool includeNewline)
+			{
+				int32_t state = NewState(NfaType::Char);
+				m_Nfa[state].Chars.set();
+				if (!includeNewline)
+				{
+					m_Nfa[state].Chars.reset('\n');
+				}
+				return Single(state);
+			}
+
+			bool AtEnd() const { return m_Cur >= m_End; }
+
+			static void AddEscapeClass(char c, std::bitset<256>& chars, bool& isClass)
+			{
+				std::bitset<256> set;
+				isClass = true;
+				switch (c)
+				{
+				case 'd': case 'D':
+					for (int32_t i = '0'; i <= '9'; i++) set.set(i);
+					break;
+				case 'w': case 'W':
+					for (int32_t i = '0'; i <= '9'; i++) set.set(i);
+					for (int32_t i = 'a'; i <= 'z'; i++) set.set(i);
+					for (int32_t i = 'A'; i <= 'Z'; i++) set.set(i);
+					set.set('_');
+					break;
+				case 's': case 'S':
+					for (int32_t i = 0; i < 256; i++)
+					{
+						if (String::IsWhitespace(static_cast<char>(i))) set.set(i);
+					}
+					break;
+				default:
+					isClass = false;
+					return;
+				}
+				if (c >= 'A' && c <= 'Z')
+				{
+					set.flip();
+				}
+				chars |= set;
+			}
+
+			static char EscapedLiteral(char c)
+			{
+				switch (c)
+				{
+				case 'n': return '\n';
+				case 't': return '\t';
+				case 'r': return '\r';
+				default: return c;
+				}
+			}
+
+			bool ParseClass(Fragment& out, bool glob)
+			{
+				// m_Cur is positioned after the opening '['
+				int32_t state = NewState(NfaType::Char);
+				std::bitset<256> chars;
+				bool negate = false;
+				if (!AtEnd() && (*m_Cur == '^' || (glob && *m_Cur == '!')))
+				{
+					negate = true;
+					m_Cur++;
+				}
+				bool first = true;
+				while (true)
+				{
+					if (AtEnd())
+					{
+						return false;
+					}
+					char c = *m_Cur++;
+					if (c == ']' && !first)
+					{
+						break;
+					}
+					first = false;
+					if (c == '\\')
+					{
+						if (AtEnd())
+						{
+							return false;
+						}
+						bool isClass = false;
+						AddEscapeClass(*m_Cur, chars, isClass);
+						c = EscapedLiteral(*m_Cur++);
+						if (isClass)
+						{
+							continue;
+						}
+					}
+					if (m_End - m_Cur >= 2 && m_Cur[0] == '-' && m_Cur[1] != ']')
+					{
+						char upper = m_Cur[1];
+						m_Cur += 2;
+						if (upper == '\\')
+						{
+							if (AtEnd())
+							{
+								return false;
+							}
+							upper = EscapedLiteral(*m_Cur++);
+						}
+						if (static_cast<uint8_t>(upper) < static_cast<uint8_t>(c))
+						{
+							return false;
+						}
+						for (int32_t i = static_cast<uint8_t>(c); i <= static_cast<uint8_t>(upper); i++)
+						{
+							chars.set(i);
+						}
+						continue;
+					}
+					chars.set(static_cast<uint8_t>(c));
+				}
+				if (negate)
+				{
+					chars.flip();
+				}
+				m_Nfa[state].Chars = chars;
+				out = Single(state);
+				return true;
+			}
+
+#pragma region Regex
+
+			bool ParseAlternation(Fragment& out)
+			{
+				if (!ParseConcat(out))
+				{
+					return false;
+				}
+				while (!AtEnd() && *m_Cur == '|')
+				{
+					m_Cur++;
+					Fragment right;
+					if (!ParseConcat(right))
+					{
+						return false;
+					}
+					out = Alternate(out, right);
+				}
+				return true;
+			}
+
+			bool ParseConcat(Fragment& out)
+			{
+				bool empty = true;
+				while (!AtEnd() && *m_Cur != '|' && *m_Cur != ')')
+				{
+					Fragment next;
+					if (!ParseRepeat(next))
+					{
+						return false;
+					}
+					if (empty)
+					{
+						out = std::move(next);
+						empty = false;
+					}
+					else
+					{
+						Chain(out, next);
+					}
+				}
+				if (empty)
+				{
+					out = Single(NewState(NfaType::Epsilon));
+				}
+				return true;
+			}
+
+			static bool IsQuantifier(char c)
+			{
+				return c == '*' || c == '+' || c == '?';
+			}
+
+			bool ParseRepeat(Fragment& out)
+			{
+				if (!ParseAtom(out))
+				{
+					return false;
+				}
+				if (!AtEnd() && IsQuantifier(*m_Cur))
+				{
+					char quantifier = *m_Cur++;
+					// Stacked quantifiers ("a+?", "a*+") look like lazy or possessive ones, which are not supported
+					if (!AtEnd() && IsQuantifier(*m_Cur))
+					{
+						return false;
+					}
+					int32_t split = NewState(NfaType::Split, out.Start);
+					if (quantifier == '*')
+					{
+						Patch(out, split);
+						out.Start = split;
+						out.Dangling.clear();
+					}
+					else if (quantifier == '+')
+					{
+						Patch(out, split);
+						out.Dangling.clear();
+					}
+					else
+					{
+						out.Start = split;
+					}
+					out.Dangling.push_back({ split, true });
+				}
+				return true;
+			}
+
+			bool ParseAtom(Fragment& out)
+			{
+				char c = *m_Cur++;
+				switch (c)
+				{
+				case '(':
+					if (!ParseAlternation(out) || AtEnd() || *m_Cur != ')')
+					{
+						return false;
+					}
+					m_Cur++;
+					return true;
+				case '[':
+					return ParseClass(out, false);
+				case '.':
+					out = AnyChar(false);
+					return true;
+				case '^':
+					out = Single(NewState(NfaType::AssertBegin));
+					return true;
+				case '$':
+					out = Single(NewState(NfaType::AssertEnd));
+					return true;
+				case '*': case '+': case '?':
+					return false;
+				case '\\':
+				{
+					if (AtEnd())
+					{
+						return false;
+					}
+					int32_t state = NewState(NfaType::Char);
+					bool isClass = false;
+					AddEscapeClass(*m_Cur, m_Nfa[state].Chars, isClass);
+					if (!isClass)
+					{
+						m_Nfa[state].Chars.set(static_cast<uint8_t>(EscapedLiteral(*m_Cur)));
+					}
+					m_Cur++;
+					out = Single(state);
+					return true;
+				}
+				default:
+					out = Literal(c);
+					return true;
+				}
+			}
+
+#pragma endregion
+#pragma region Glob
+
+			bool ParseGlobSequence(Fragment& out, bool inBraces)
+			{
+				bool empty = true;
+				while (!AtEnd() && !(inBraces && (*m_Cur == ',' || *m_Cur == '}')))
+				{
+					Fragment next;
+					char c = *m_Cur++;
+					switch (c)
+					{
+					case '*':
+					{
+						Fragment any = AnyChar(true);
+						int32_t split = NewState(NfaType::Split, any.Start);
+						Patch(any, split);
+						next.Start = split;
+						next.Dangling.push_back({ split, true });
+						break;
+					}
+					case '?':
+						next = AnyChar(true);
+						break;
+					case '[':
+						if (!ParseClass(next, true))
+						{
+							return false;
+						}
+						break;
+					case '{':
+						if (!ParseGlobAlternatives(next))
+						{
+							return false;
+						}
+						break;
+					case '\\':
+						if (AtEnd())
+						{
+							return false;
+						}
+						next = Literal(*m_Cur++);
+						break;
+					default:
+						next = Literal(c);
+						break;
+					}
+					if (empty)
+					{
+						out = std::move(next);
+						empty = false;
+					}
+					else
+					{
+						Chain(out, next);
+					}
+				}
+				if (empty)
+				{
+					out = Single(NewState(NfaType::Epsilon));
+				}
+				return true;
+			}
+
+			bool ParseGlobAlternatives(Fragment& out)
+			{
+				// m_Cur is positioned after the opening '{'
+				if (!ParseGlobSequence(out, true))
+				{
+					return false;
+				}
+				while (!AtEnd() && *m_Cur == ',')
+				{
+					m_Cur++;
+					Fragment right;
+					if (!ParseGlobSequence(right, true))
+					{
+						return false;
+					}
+					out = Alternate(out, right);
+				}
+				if (AtEnd() || *m_Cur != '}')
+				{
+					return false;
+				}
+				m_Cur++;
+				return true;
+			}
+
+#pragma endregion
+
+		public:
+			Compiler(std::vector<NfaState>& nfa, const String& source) : m_Nfa(nfa), m_Cur(source.Data()), m_End(source.Data() + source.Length()) {}
+
+			/// @brief Builds the NFA, returns the start state or -1 on syntax errors
+			int32_t Compile(bool glob)
+			{
+				Fragment frag;
+				bool result = glob ? ParseGlobSequence(frag, false) : ParseAlternation(frag);
+				if (!result || !AtEnd())
+				{
+					return -1;
+				}
+				Patch(frag, NewState(NfaType::Match));
+				return frag.Start;
+			}
+
+			static bool Compile(const String& source, Pattern& out, bool glob)
+			{
+				Pattern result;
+				Compiler compiler(result.m_Nfa, source);
+				result.m_Start = compiler.Compile(glob);
+				if (result.m_Start < 0)
+				{
+					return false;
+				}
+				result.m_Search = !glob;
+				result.Finalize();
+				out = std::move(result);
+				return true;
+			}
+		};
+	}
+
+#pragma region Compilation
+
+	inline bool Pattern::TryCompileRegex(const String& source, Pattern& out)
+	{
+		return pattern::Compiler::Compile(source, out, false);
+	}
+
+	inline bool Pattern::TryCompileGlob(const String& source, Pattern& out)
+	{
+		return pattern::Compiler::Compile(source, out, true);
+	}
+
+	inline bool Pattern::IsValid() const
+	{
+		return m_Start >= 0;
+	}
+
+	inline void Pattern::Finalize()
+	{
+		m_Marks.assign(m_Nfa.size(), 0);
+		m_Generation = 0;
+		ResetCache();
+
+		// A search can skip ahead with memchr while no match is in progress, if every match has to begin with the same byte
+		m_PrefilterByte = -1;
+		if (!m_Search)
+		{
+			return;
+		}
+		const std::vector<int32_t>& restart = m_Dfa[STATE_RESTART].NfaStates;
+		std::bitset<256> firstBytes;
+		for (int32_t state : restart)
+		{
+			if (m_Nfa[state].Type != pattern::NfaType::Char)
+			{
+				return;
+			}
+			firstBytes |= m_Nfa[state].Chars;
+		}
+		if (firstBytes.count() == 1)
+		{
+			for (int32_t i = 0; i < 256; i++)
+			{
+				if (firstBytes.test(i))
+				{
+					m_PrefilterByte = i;
+				}
+			}
+		}
+	}
+
+#pragma endregion
+#pragma region DFA construction
+
+	inline void Pattern::Closure(std::vector<int32_t>& out, int32_t state, bool atBegin, bool atEnd) const
+	{
+		using namespace pattern;
+
+		m_Stack.clear();
+		m_Stack.push_back(state);
+		while (!m_Stack.empty())
+		{
+			int32_t current = m_Stack.back();
+			m_Stack.pop_back();
+			if (current < 0 || m_Marks[current] == m_Generation)
+			{
+				continue;
+			}
+			m_Marks[current] = m_Generation;
+			const NfaState& nfaState = m_Nfa[current];
+			switch (nfaState.Type)
+			{
+			case NfaType::Split:
+				m_Stack.push_back(nfaState.Out1);
+				m_Stack.push_back(nfaState.Out);
+				break;
+			case NfaType::Epsilon:
+				m_Stack.push_back(nfaState.Out);
+				break;
+			case NfaType::AssertBegin:
+				if (atBegin)
+				{
+					m_Stack.push_back(nfaState.Out);
+				}
+				break;
+			case NfaType::AssertEnd:
+				if (atEnd)
+				{
+					m_Stack.push_back(nfaState.Out);
+				}
+				else
+				{
+					out.push_back(current);
+				}
+				break;
+			default:
+				out.push_back(current);
+				break;
+			}
+		}
+	}
+
+	inline int32_t Pattern::AddDfaState(std::vector<int32_t>& nfaStates, bool isBegin) const
+	{
+		using namespace pattern;
+
+		std::sort(nfaStates.begin(), nfaStates.end());
+		if (isBegin)
+		{
+			nfaStates.push_back(-1); // keeps the begin state distinct from an identical set reached later on
+		}
+		std::map<std::vector<int32_t>, int32_t>::iterator found = m_DfaLookup.find(nfaStates);
+		if (found != m_DfaLookup.end())
+		{
+			return found->second;
+		}
+
+		DfaState dfaState;
+		dfaState.Accepting = false;
+		dfaState.AcceptingAtEnd = false;
+		std::vector<int32_t> atEnd;
+		for (int32_t state : nfaStates)
+		{
+			if (state < 0)
+			{
+				continue;
+			}
+			if (m_Nfa[state].Type == NfaType::Match)
+			{
+				dfaState.Accepting = true;
+			}
+			else if (m_Nfa[state].Type == NfaType::AssertEnd)
+			{
+				m_Generation++;
+				Closure(atEnd, m_Nfa[state].Out, isBegin, true);
+			}
+		}
+		dfaState.AcceptingAtEnd = dfaState.Accepting;
+		for (int32_t state : atEnd)
+		{
+			dfaState.AcceptingAtEnd |= m_Nfa[state].Type == NfaType::Match;
+		}
+
+		int32_t index = static_cast<int32_t>(m_Dfa.size());
+		dfaState.NfaStates = nfaStates;
+		m_DfaLookup.emplace(nfaStates, index);
+		m_Dfa.push_back(std::move(dfaState));
+		m_Transitions.resize(m_Transitions.size() + 256, -1);
+		return index;
+	}
+
+	inline void Pattern::ResetCache() const
+	{
+		m_Dfa.clear();
+		m_Transitions.clear();
+		m_DfaLookup.clear();
+		if (m_Start < 0)
+		{
+			return;
+		}
+
+		std::vector<int32_t> states;
+		m_Generation++;
+		Closure(states, m_Start, true, false);
+		AddDfaState(states, true); // STATE_BEGIN
+
+		states.clear();
+		AddDfaState(states, false); // STATE_DEAD
+
+		if (m_Search)
+		{
+			states.clear();
+			m_Generation++;
+			Closure(states, m_Start, false, false);
+			int32_t restart = AddDfaState(states, false); // STATE_RESTART
+			if (restart != STATE_RESTART)
+			{
+				// The restart set is empty and equals the dead state, duplicate it to keep the index fixed
+				m_Dfa.push_back(m_Dfa[restart]);
+				m_Transitions.resize(m_Transitions.size() + 256, -1);
+			}
+		}
+	}
+
+	inline int32_t Pattern::ComputeTransition(int32_t state, uint8_t character) const
+	{
+		using namespace pattern;
+
+		m_Scratch.clear();
+		m_Generation++;
+		for (int32_t nfaState : m_Dfa[state].NfaStates)
+		{
+			if (nfaState >= 0 && m_Nfa[nfaState].Type == NfaType::Char && m_Nfa[nfaState].Chars.test(character))
+			{
+				Closure(m_Scratch, m_Nfa[nfaState].Out, false, false);
+			}
+		}
+		if (m_Search)
+		{
+			Closure(m_Scratch, m_Start, false, false);
+		}
+
+		if (m_Dfa.size() >= MAXDFASTATES)
+		{
+			// Cache exhausted: start over, the caller continues from the returned state
+			ResetCache();
+			return AddDfaState(m_Scratch, false);
+		}
+		int32_t next = AddDfaState(m_Scratch, false);
+		m_Transitions[static_cast<size_t>(state) * 256 + character] = next;
+		return next;
+	}
+
+#pragma endregion
+#pragma region Matching
+
+	inline bool Pattern::Matches(const String& text) const
+	{
+		if (!IsValid())
+		{
+			return false;
+		}
+
+		const uint8_t* data = reinterpret_cast<const uint8_t*>(text.Data());
+		const size_t length = text.Length();
+		int32_t state = STATE_BEGIN;
+		for (size_t index = 0; index < length; index++)
+		{
+			if (m_Search && m_Dfa[state].Accepting)
+			{
+				return true;
+			}
+			if (state == STATE_RESTART && m_PrefilterByte >= 0)
+			{
+				const void* next = memchr(data + index, m_PrefilterByte, length - index);
+				if (!next)
+				{
+					break;
+				}
+				index = static_cast<const uint8_t*>(next) - data;
+			}
+			int32_t next = m_Transitions[static_cast<size_t>(state) * 256 + data[index]];
+			if (next < 0)
+			{
+				next = ComputeTransition(state, data[index]);
+			}
+			if (next == STATE_DEAD)
+			{
+				return false;
+			}
+			state = next;
+		}
+		return m_Dfa[state].AcceptingAtEnd;
+	}
+
+#pragma endregion
+}
\ No newline at end of file
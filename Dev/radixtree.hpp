@@ -0,0 +1,116 @@
+#pragma once
+#include "string.hpp"
+
+namespace jht {
+
+	/// @brief Adaptive radix tree (ART) mapping String keys to values
+	/// @details Inner nodes grow through the widths 4, 16, 48 and 256, common key sections are path compressed.
+	/// Keys are copied into managed storage on insertion. All lookups work on the passed String directly and never allocate.
+	/// Keys are ordered by unsigned byte value.
+	template<typename TValue>
+	class RadixTree
+	{
+	public:
+		/// @brief A key value pair stored in the tree
+		struct Entry
+		{
+			String Key;
+			TValue Value;
+		};
+
+	private:
+		enum class NodeType : uint8_t
+		{
+			Node4,
+			Node16,
+			Node48,
+			Node256
+		};
+
+		struct Node
+		{
+			NodeType Type;
+			uint16_t Count;
+			uint32_t PrefixLength;
+			const char* Prefix;  // points into the key of an entry stored below this node
+			Entry* Terminal;     // entry whose key ends exactly after this node's prefix
+
+			Node(NodeType type) : Type(type), Count(0), PrefixLength(0), Prefix(nullptr), Terminal(nullptr) {}
+		};
+
+		struct Node4 : Node
+		{
+			uint8_t Keys[4];
+			void* Children[4];
+			Node4() : Node(NodeType::Node4), Keys(), Children() {}
+		};
+
+		struct Node16 : Node
+		{
+			uint8_t Keys[16];
+			void* Children[16];
+			Node16() : Node(NodeType::Node16), Keys(), Children() {}
+		};
+
+		struct Node48 : Node
+		{
+			static const uint8_t EMPTY = 0xFF;
+			uint8_t Index[256];
+			void* Children[48];
+			Node48() : Node(NodeType::Node48), Index(), Children() { memset(Index, EMPTY, sizeof(Index)); }
+		};
+
+		struct Node256 : Node
+		{
+			void* Children[256];
+			Node256() : Node(NodeType::Node256), Children() {}
+		};
+
+		// Children are either Node* or Entry* tagged with the lowest bit
+		void* m_Root;
+		size_t m_Count;
+
+		static bool IsEntry(const void* child) { return reinterpret_cast<uintptr_t>(child) & 1; }
+		static Entry* AsEntry(const void* child) { return reinterpret_cast<Entry*>(reinterpret_cast<uintptr_t>(child) & ~uintptr_t(1)); }
+		static Node* AsNode(const void* child) { return reinterpret_cast<Node*>(const_cast<void*>(child)); }
+		static void* TagEntry(Entry* entry) { return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(entry) | 1); }
+
+		static void** FindChild(Node* node, uint8_t key);
+		static void AddChild(void** ref, Node* node, uint8_t key, void* child);
+		static void CopyHeader(Node* destination, const Node* source);
+		static void Free(void* child);
+		static size_t CommonPrefix(const char* left, const char* right, size_t maxLength);
+		static bool MatchesPrefix(const Node* node, const String& key, size_t depth);
+
+		template<typename TFunc>
+		static void Visit(const void* child, TFunc& func);
+
+		bool InsertAt(void** ref, const String& key, size_t depth, const TValue& value);
+	public:
+		RadixTree() : m_Root(nullptr), m_Count(0) {}
+		~RadixTree();
+		RadixTree(const RadixTree&) = delete;
+		RadixTree& operator=(const RadixTree&) = delete;
+
+		/// @brief Count of stored keys
+		size_t Count() const { return m_Count; }
+		/// @brief Removes all keys
+		void Clear();
+
+		/// @brief Inserts a key or overwrites the value of an existing key
+		/// @return true if the key was not present before
+		bool Insert(const String& key, const TValue& value);
+		/// @brief Exact lookup
+		/// @return pointer to the stored value or nullptr
+		TValue* Find(const String& key);
+		/// @brief Exact lookup
+		/// @return pointer to the stored value or nullptr
+		const TValue* Find(const String& key) const;
+		/// @brief Finds the longest stored key that is a prefix of key
+		/// @return the matching entry or nullptr
+		const Entry* LongestPrefix(const String& key) const;
+		/// @brief Calls func(const Entry&) for every stored key starting with prefix, in key order
+		template<typename TFunc>
+		void ForEachWithPrefix(const String& prefix, TFunc func) const;
+	};
+}
\ No newline at end of file
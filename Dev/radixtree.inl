@@ -0,0 +1,538 @@
+#pragma once
+#include "radixtree.hpp"
+
+namespace jht
+{
+#pragma region Node operations
+
+	template<typename TValue>
+	inline void** RadixTree<TValue>::FindChild(Node* node, uint8_t key)
+	{
+		switch (node->Type)
+		{
+		case NodeType::Node4:
+		{
+			Node4* node4 = static_cast<Node4*>(node);
+			for (uint16_t i = 0; i < node4->Count; i++)
+			{
+				if (node4->Keys[i] == key)
+				{
+					return &node4->Children[i];
+				}
+			}
+			return nullptr;
+		}
+		case NodeType::Node16:
+		{
+			Node16* node16 = static_cast<Node16*>(node);
+#ifdef JHT_STRING_SSE2
+			__m128i matches = _mm_cmpeq_epi8(_mm_set1_epi8(static_cast<char>(key)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(node16->Keys)));
+			uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(matches)) & ((1u << node16->Count) - 1);
+			if (mask)
+			{
+				uint32_t index = 0;
+				while (!(mask & 1))
+				{
+					mask >>= 1;
+					index++;
+				}
+				return &node16->Children[index];
+			}
+#else
+			for (uint16_t i = 0; i < node16->Count; i++)
+			{
+				if (node16->Keys[i] == key)
+				{
+					return &node16->Children[i];
+				}
+			}
+#endif
+			return nullptr;
+		}
+		case NodeType::Node48:
+		{
+			Node48* node48 = static_cast<Node48*>(node);
+			uint8_t index = node48->Index[key];
+			return index == Node48::EMPTY ? nullptr : &node48->Children[index];
+		}
+		default:
+		{
+			Node256* node256 = static_cast<Node256*>(node);
+			return node256->Children[key] ? &node256->Children[key] : nullptr;
+		}
+		}
+	}
+
+	namespace radixtree
+	{
+		inline void SortedInsert(uint8_t* keys, void** children, uint16_t count, uint8_t key, void* child)
+		{
+			uint16_t position = 0;
+			while (position < count && keys[position] < key)
+			{
+				position++;
+			}
+			memmove(keys + position + 1, keys + position, count - position);
+			memmove(children + position + 1, children + position, (count - position) * sizeof(void*));
+			keys[position] = key;
+			children[position] = child;
+		}
+	}
+
+	template<typename TValue>
+	inline void RadixTree<TValue>::CopyHeader(Node* destination, const Node* source)
+	{
+		destination->Count = source->Count;
+		destination->PrefixLength = source->PrefixLength;
+		destination->Prefix = source->Prefix;
+		destination->Terminal = source->Terminal;
+	}
+
+	template<typename TValue>
+	inline void RadixTree<TValue>::AddChild(void** ref, Node* node, uint8_t key, void* child)
+	{
+		switch (node->Type)
+		{
+		case NodeType::Node4:
+		{
+			Node4* node4 = static_cast<Node4*>(node);
+			if (node4->Count < 4)
+			{
+				radixtree::SortedInsert(node4->Keys, node4->Children, node4->Count, key, child);
+				node4->Count++;
+				return;
+			}
+			Node16* grown = new Node16();
+			CopyHeader(grown, node4);
+			ArrCopy(grown->Keys, node4->Keys, 4);
+			ArrCopy(grown->Children, node4->Children, 4);
+			delete node4;
+			*ref = grown;
+			AddChild(ref, grown, key, child);
+			return;
+		}
+		case NodeType::Node16:
+		{
+			Node16* node16 = static_cast<Node16*>(node);
+			if (node16->Count < 16)
+			{
+				radixtree::SortedInsert(node16->Keys, node16->Children, node16->Count, key, child);
+				node16->Count++;
+				return;
+			}
+			Node48* grown = new Node48();
+			CopyHeader(grown, node16);
+			for (uint8_t i = 0; i < 16; i++)
+			{
+				grown->Index[node16->Keys[i]] = i;
+				grown->Children[i] = node16->Children[i];
+			}
+			delete node16;
+			*ref = grown;
+			AddChild(ref, grown, key, child);
+			return;
+		}
+		case NodeType::Node48:
+		{
+			Node48* node48 = static_cast<Node48*>(node);
+			if (node48->Count < 48)
+			{
+				uint8_t slot = 0;
+				while (node48->Children[slot])
+				{
+					slot++;
+				}
+				node48->Index[key] = slot;
+				node48->Children[slot] = child;
+				node48->Count++;
+				return;
+			}
+			Node256* grown = new Node256();
+			CopyHeader(grown, node48);
+			for (int32_t i = 0; i < 256; i++)
+			{
+				if (node48->Index[i] != Node48::EMPTY)
+				{
+					grown->Children[i] = node48->Children[node48->Index[i]];
+				}
+			}
+			delete node48;
+			*ref = grown;
+			AddChild(ref, grown, key, child);
+			return;
+		}
+		default:
+		{
+			Node256* node256 = static_cast<Node256*>(node);
+			node256->Children[key] = child;
+			node256->Count++;
+			return;
+		}
+		}
+	}
+
+	template<typename TValue>
+	inline void RadixTree<TValue>::Free(void* child)
+	{
+		if (!child)
+		{
+			return;
+		}
+		if (IsEntry(child))
+		{
+			delete AsEntry(child);
+			return;
+		}
+		Node* node = AsNode(child);
+		delete node->Terminal;
+		switch (node->Type)
+		{
+		case NodeType::Node4:
+			for (uint16_t i = 0; i < node->Count; i++)
+			{
+				Free(static_cast<Node4*>(node)->Children[i]);
+			}
+			delete static_cast<Node4*>(node);
+			break;
+		case NodeType::Node16:
+			for (uint16_t i = 0; i < node->Count; i++)
+			{
+				Free(static_cast<Node16*>(node)->Children[i]);
+			}
+			delete static_cast<Node16*>(node);
+			break;
+		case NodeType::Node48:
+			for (uint16_t i = 0; i < node->Count; i++)
+			{
+				Free(static_cast<Node48*>(node)->Children[i]);
+			}
+			delete static_cast<Node48*>(node);
+			break;
+		default:
+			for (int32_t i = 0; i < 256; i++)
+			{
+				Free(static_cast<Node256*>(node)->Children[i]);
+			}
+			delete static_cast<Node256*>(node);
+			break;
+		}
+	}
+
+	template<typename TValue>
+	inline size_t RadixTree<TValue>::CommonPrefix(const char* left, const char* right, size_t maxLength)
+	{
+		size_t length = 0;
+		while (length < maxLength && left[length] == right[length])
+		{
+			length++;
+		}
+		return length;
+	}
+
+	template<typename TValue>
+	inline bool RadixTree<TValue>::MatchesPrefix(const Node* node, const String& key, size_t depth)
+	{
+		return key.Length() - depth >= node->PrefixLength && memcmp(key.Data() + depth, node->Prefix, node->PrefixLength) == 0;
+	}
+
+#pragma endregion
+#pragma region Modification
+
+	template<typename TValue>
+	inline RadixTree<TValue>::~RadixTree()
+	{
+		Free(m_Root);
+	}
+
+	template<typename TValue>
+	inline void RadixTree<TValue>::Clear()
+	{
+		Free(m_Root);
+		m_Root = nullptr;
+		m_Count = 0;
+	}
+
+	template<typename TValue>
+	inline bool RadixTree<TValue>::Insert(const String& key, const TValue& value)
+	{
+		bool inserted = InsertAt(&m_Root, key, 0, value);
+		if (inserted)
+		{
+			m_Count++;
+		}
+		return inserted;
+	}
+
+	template<typename TValue>
+	inline bool RadixTree<TValue>::InsertAt(void** ref, const String& key, size_t depth, const TValue& value)
+	{
+		while (true)
+		{
+			void* current = *ref;
+			if (!current)
+			{
+				*ref = TagEntry(new Entry{ key.AsManaged(), value });
+				return true;
+			}
+
+			if (IsEntry(current))
+			{
+				Entry* existing = AsEntry(current);
+				if (existing->Key == key)
+				{
+					existing->Value = value;
+					return false;
+				}
+				// Lazy expansion ends here: both keys get a node holding their common section
+				Entry* entry = new Entry{ key.AsManaged(), value };
+				const String& existingKey = existing->Key;
+				size_t common = CommonPrefix(existingKey.ConstData() + depth, entry->Key.ConstData() + depth, min(existingKey.Length(), key.Length()) - depth);
+				Node4* node = new Node4();
+				node->Prefix = entry->Key.ConstData() + depth;
+				node->PrefixLength = static_cast<uint32_t>(common);
+				size_t split = depth + common;
+				if (split == existingKey.Length())
+				{
+					node->Terminal = existing;
+				}
+				else
+				{
+					AddChild(ref, node, static_cast<uint8_t>(existingKey[split]), TagEntry(existing));
+				}
+				if (split == key.Length())
+				{
+					node->Terminal = entry;
+				}
+				else
+				{
+					AddChild(ref, node, static_cast<uint8_t>(key[split]), TagEntry(entry));
+				}
+				*ref = node;
+				return true;
+			}
+
+			Node* node = AsNode(current);
+			if (node->PrefixLength)
+			{
+				size_t common = CommonPrefix(node->Prefix, key.Data() + depth, min(static_cast<size_t>(node->PrefixLength), key.Length() - depth));
+				if (common < node->PrefixLength)
+				{
+					// Split the compressed path at the first mismatch
+					Node4* parent = new Node4();
+					parent->Prefix = node->Prefix;
+					parent->PrefixLength = static_cast<uint32_t>(common);
+					uint8_t nodeKey = static_cast<uint8_t>(node->Prefix[common]);
+					node->Prefix += common + 1;
+					node->PrefixLength -= static_cast<uint32_t>(common + 1);
+					void* parentRef = parent;
+					AddChild(&parentRef, parent, nodeKey, node);
+
+					Entry* entry = new Entry{ key.AsManaged(), value };
+					size_t split = depth + common;
+					if (split == key.Length())
+					{
+						parent->Terminal = entry;
+					}
+					else
+					{
+						AddChild(&parentRef, parent, static_cast<uint8_t>(key[split]), TagEntry(entry));
+					}
+					*ref = parent;
+					return true;
+				}
+				depth += node->PrefixLength;
+			}
+
+			if (depth == key.Length())
+			{
+				if (node->Terminal)
+				{
+					node->Terminal->Value = value;
+					return false;
+				}
+				node->Terminal = new Entry{ key.AsManaged(), value };
+				return true;
+			}
+
+			uint8_t next = static_cast<uint8_t>(key[depth]);
+			void** child = FindChild(node, next);
+			if (!child)
+			{
+				AddChild(ref, node, next, TagEntry(new Entry{ key.AsManaged(), value }));
+				return true;
+			}
+			ref = child;
+			depth++;
+		}
+	}
+
+#pragma endregion
+#pragma region Lookup
+
+	template<typename TValue>
+	inline TValue* RadixTree<TValue>::Find(const String& key)
+	{
+		return const_cast<TValue*>(static_cast<const RadixTree<TValue>*>(this)->Find(key));
+	}
+
+	template<typename TValue>
+	inline const TValue* RadixTree<TValue>::Find(const String& key) const
+	{
+		const void* current = m_Root;
+		size_t depth = 0;
+		while (current)
+		{
+			if (IsEntry(current))
+			{
+				Entry* entry = AsEntry(current);
+				return entry->Key == key ? &entry->Value : nullptr;
+			}
+			Node* node = AsNode(current);
+			if (!MatchesPrefix(node, key, depth))
+			{
+				return nullptr;
+			}
+			depth += node->PrefixLength;
+			if (depth == key.Length())
+			{
+				return node->Terminal ? &node->Terminal->Value : nullptr;
+			}
+			void** child = FindChild(node, static_cast<uint8_t>(key[depth]));
+			current = child ? *child : nullptr;
+			depth++;
+		}
+		return nullptr;
+	}
+
+	template<typename TValue>
+	inline const typename RadixTree<TValue>::Entry* RadixTree<TValue>::LongestPrefix(const String& key) const
+	{
+		const Entry* best = nullptr;
+		const void* current = m_Root;
+		size_t depth = 0;
+		while (current)
+		{
+			if (IsEntry(current))
+			{
+				Entry* entry = AsEntry(current);
+				if (entry->Key.Length() <= key.Length() && memcmp(entry->Key.ConstData(), key.Data(), entry->Key.Length()) == 0)
+				{
+					best = entry;
+				}
+				break;
+			}
+			Node* node = AsNode(current);
+			if (!MatchesPrefix(node, key, depth))
+			{
+				break;
+			}
+			depth += node->PrefixLength;
+			if (node->Terminal)
+			{
+				best = node->Terminal;
+			}
+			if (depth == key.Length())
+			{
+				break;
+			}
+			void** child = FindChild(node, static_cast<uint8_t>(key[depth]));
+			current = child ? *child : nullptr;
+			depth++;
+		}
+		return best;
+	}
+
+	template<typename TValue>
+	template<typename TFunc>
+	inline void RadixTree<TValue>::Visit(const void* child, TFunc& func)
+	{
+		if (IsEntry(child))
+		{
+			func(static_cast<const Entry&>(*AsEntry(child)));
+			return;
+		}
+		const Node* node = AsNode(child);
+		if (node->Terminal)
+		{
+			func(static_cast<const Entry&>(*node->Terminal));
+		}
+		switch (node->Type)
+		{
+		case NodeType::Node4:
+			for (uint16_t i = 0; i < node->Count; i++)
+			{
+				Visit(static_cast<const Node4*>(node)->Children[i], func);
+			}
+			break;
+		case NodeType::Node16:
+			for (uint16_t i = 0; i < node->Count; i++)
+			{
+				Visit(static_cast<const Node16*>(node)->Children[i], func);
+			}
+			break;
+		case NodeType::Node48:
+		{
+			const Node48* node48 = static_cast<const Node48*>(node);
+			for (int32_t i = 0; i < 256; i++)
+			{
+				if (node48->Index[i] != Node48::EMPTY)
+				{
+					Visit(node48->Children[node48->Index[i]], func);
+				}
+			}
+			break;
+		}
+		default:
+			for (int32_t i = 0; i < 256; i++)
+			{
+				const void* grandchild = static_cast<const Node256*>(node)->Children[i];
+				if (grandchild)
+				{
+					Visit(grandchild, func);
+				}
+			}
+			break;
+		}
+	}
+
+	template<typename TValue>
+	template<typename TFunc>
+	inline void RadixTree<TValue>::ForEachWithPrefix(const String& prefix, TFunc func) const
+	{
+		const void* current = m_Root;
+		size_t depth = 0;
+		while (current)
+		{
+			if (IsEntry(current))
+			{
+				const Entry* entry = AsEntry(current);
+				if (entry->Key.Length() >= prefix.Length() && memcmp(entry->Key.ConstData(), prefix.Data(), prefix.Length()) == 0)
+				{
+					func(*entry);
+				}
+				return;
+			}
+			Node* node = AsNode(current);
+			size_t remaining = prefix.Length() - depth;
+			if (remaining <= node->PrefixLength)
+			{
+				// The requested prefix ends within this node's compressed path
+				if (memcmp(prefix.Data() + depth, node->Prefix, remaining) == 0)
+				{
+					Visit(current, func);
+				}
+				return;
+			}
+			if (!MatchesPrefix(node, prefix, depth))
+			{
+				return;
+			}
+			depth += node->PrefixLength;
+			void** child = FindChild(node, static_cast<uint8_t>(prefix[depth]));
+			current = child ? *child : nullptr;
+			depth++;
+		}
+	}
+
+#pragma endregion
+}
\ No newline at end of file
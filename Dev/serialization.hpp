@@ -0,0 +1,90 @@
+#pragma once
+#include <vector>
+#include <utility>
+#include "string.hpp"
+#include "stringbuilder.hpp"
+
+namespace jht {
+
+	/// @brief Read access to String collections serialized by SerializeStrings or SerializeStringMap
+	/// @details Format: varint count, flags byte, varint blob size, then either one varint length per string or (indexed) one fixed width
+	/// little endian offset per string, followed by the blob holding all strings back to back. Map entries are stored as key, value, key, value...
+	/// All returned Strings are views into the serialized buffer, which has to stay valid while they are used.
+	class SerializedStrings
+	{
+	private:
+		String m_Data;
+		size_t m_Count;
+		uint8_t m_Flags;
+		const uint8_t* m_Table;  // lengths or offsets
+		const char* m_Blob;
+		size_t m_BlobSize;
+
+		size_t Offset(size_t index) const;
+
+	public:
+		/// @brief Flag marking a serialization with offset index
+		static const uint8_t FLAG_INDEXED = 0b001;
+		/// @brief Flag marking a serialization of key value pairs
+		static const uint8_t FLAG_PAIRS = 0b010;
+		/// @brief Flag marking 8 byte instead of 4 byte offsets
+		static const uint8_t FLAG_WIDEOFFSETS = 0b100;
+
+		/// @brief Sequentially visits the serialized strings, in O(1) per string with or without index
+		class Iterator
+		{
+		private:
+			const SerializedStrings* m_Source;
+			size_t m_Index;
+			const uint8_t* m_Table;
+			size_t m_Offset;
+			String m_Current;
+
+			void Decode();
+		public:
+			Iterator(const SerializedStrings& source);
+
+			/// @brief Exposes the current string
+			const String& operator*() const { return m_Current; }
+			/// @brief Exposes the current string
+			const String& Current() const { return m_Current; }
+			/// @brief Advances the iterator to the next string
+			void operator++();
+			/// @brief Returns true if the iterator points to a string
+			operator bool() const { return m_Index < m_Source->m_Count; }
+			/// @brief Position of the current string
+			size_t Index() const { return m_Index; }
+		};
+
+		SerializedStrings() : m_Data(), m_Count(0), m_Flags(0), m_Table(nullptr), m_Blob(nullptr), m_BlobSize(0) {}
+
+		/// @brief Validates a serialized buffer and prepares access to it. Nothing is copied
+		/// @return false if data is not a valid serialization
+		static bool TryOpen(const String& data, SerializedStrings& out);
+
+		/// @brief Count of serialized strings (twice the count of pairs for maps)
+		size_t Count() const { return m_Count; }
+		/// @brief True if the serialization contains key value pairs
+		bool HasPairs() const { return (m_Flags & FLAG_PAIRS) != 0; }
+		/// @brief True if the serialization contains an offset index
+		bool IsIndexed() const { return (m_Flags & FLAG_INDEXED) != 0; }
+
+		/// @brief Returns a view of the string at index. O(1) if indexed, otherwise the lengths before it are summed up
+		String Get(size_t index) const;
+		/// @brief Appends views of all strings to out
+		void ReadAll(std::vector<String>& out) const;
+		/// @brief Appends views of all key value pairs to out
+		void ReadPairs(std::vector<std::pair<String, String>>& out) const;
+	};
+
+	/// @brief Serializes values to out. The strings themselves are appended to out unchanged
+	/// @param withIndex adds an offset index for O(1) random access
+	inline void SerializeStrings(const std::vector<String>& values, StringBuilder& out, bool withIndex = false);
+	/// @brief Serializes the key value pairs of a map (or any range of pairs of String) to out
+	/// @param withIndex adds an offset index for O(1) random access
+	template<typename TMap>
+	void SerializeStringMap(const TMap& map, StringBuilder& out, bool withIndex = false);
+	/// @brief Appends views of all strings serialized in data to out
+	/// @return false if data is not a valid serialization
+	inline bool TryDeserializeStrings(const String& data, std::vector<String>& out);
+}
\ No newline at end of file
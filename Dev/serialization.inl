@@ -0,0 +1,273 @@
+#pragma once
+#include "serialization.hpp"
+#include "varint.hpp"
+#include <cassert>
+#include <string>
+#include <string_view>
+
+namespace jht
+{
+	namespace serialization
+	{
+		inline String View(const String& value)
+		{
+			return value;
+		}
+
+		inline String View(const std::string& value)
+		{
+			return String::MakeView(value.data(), value.length());
+		}
+
+		inline String View(const std::string_view& value)
+		{
+			return String::MakeView(value);
+		}
+
+		inline void Write(const std::vector<String>& values, uint8_t flags, StringBuilder& out)
+		{
+			uint64_t blobSize = 0;
+			for (const String& value : values)
+			{
+				blobSize += value.Length();
+			}
+			if (blobSize > UINT32_MAX)
+			{
+				flags |= SerializedStrings::FLAG_WIDEOFFSETS;
+			}
+
+			std::vector<uint8_t> header;
+			varint::Append(header, values.size());
+			header.push_back(flags);
+			varint::Append(header, blobSize);
+			if (flags & SerializedStrings::FLAG_INDEXED)
+			{
+				size_t width = (flags & SerializedStrings::FLAG_WIDEOFFSETS) ? 8 : 4;
+				uint64_t offset = 0;
+				for (const String& value : values)
+				{
+					for (size_t byte = 0; byte < width; byte++)
+					{
+						header.push_back(static_cast<uint8_t>(offset >> (8 * byte)));
+					}
+					offset += value.Length();
+				}
+			}
+			else
+			{
+				for (const String& value : values)
+				{
+					varint::Append(header, value.Length());
+				}
+			}
+
+			out.Append(String::MakeManaged(reinterpret_cast<const char*>(header.data()), header.size()));
+			for (const String& value : values)
+			{
+				out.Append(value);
+			}
+		}
+	}
+
+#pragma region Writing
+
+	inline void SerializeStrings(const std::vector<String>& values, StringBuilder& out, bool withIndex)
+	{
+		serialization::Write(values, withIndex ? SerializedStrings::FLAG_INDEXED : 0, out);
+	}
+
+	template<typename TMap>
+	void SerializeStringMap(const TMap& map, StringBuilder& out, bool withIndex)
+	{
+		std::vector<String> values;
+		for (const auto& entry : map)
+		{
+			values.push_back(serialization::View(entry.first));
+			values.push_back(serialization::View(entry.second));
+		}
+		serialization::Write(values, SerializedStrings::FLAG_PAIRS | (withIndex ? SerializedStrings::FLAG_INDEXED : 0), out);
+	}
+
+#pragma endregion
+#pragma region Reading
+
+	inline bool SerializedStrings::TryOpen(const String& data, SerializedStrings& out)
+	{
+		out = SerializedStrings();
+		const uint8_t* input = reinterpret_cast<const uint8_t*>(data.ConstData());
+		const uint8_t* end = input + data.Length();
+
+		uint64_t count = 0;
+		uint64_t blobSize = 0;
+		size_t read = varint::Decode(input, end, count);
+		if (!read || input + read == end)
+		{
+			return false;
+		}
+		input += read;
+		uint8_t flags = *input++;
+		read = varint::Decode(input, end, blobSize);
+		if (!read || (flags & ~(FLAG_INDEXED | FLAG_PAIRS | FLAG_WIDEOFFSETS)) || ((flags & FLAG_PAIRS) && count % 2))
+		{
+			return false;
+		}
+		input += read;
+
+		const uint8_t* table = input;
+		if (flags & FLAG_INDEXED)
+		{
+			size_t width = (flags & FLAG_WIDEOFFSETS) ? 8 : 4;
+			if (count > static_cast<uint64_t>(end - input) / width)
+			{
+				return false;
+			}
+			input += count * width;
+			out.m_Flags = flags;
+			out.m_Table = table;
+			out.m_Count = static_cast<size_t>(count);
+			out.m_BlobSize = static_cast<size_t>(blobSize);
+			for (size_t index = 0; index < count; index++)
+			{
+				uint64_t offset = out.Offset(index);
+				if ((index == 0 && offset != 0) || offset > blobSize || (index > 0 && offset < out.Offset(index - 1)))
+				{
+					out = SerializedStrings();
+					return false;
+				}
+			}
+		}
+		else
+		{
+			uint64_t total = 0;
+			for (uint64_t index = 0; index < count; index++)
+			{
+				uint64_t length = 0;
+				read = varint::Decode(input, end, length);
+				if (!read || length > blobSize - total)
+				{
+					return false;
+				}
+				input += read;
+				total += length;
+			}
+			if (total != blobSize)
+			{
+				return false;
+			}
+		}
+		if (static_cast<uint64_t>(end - input) != blobSize)
+		{
+			out = SerializedStrings();
+			return false;
+		}
+
+		out.m_Data = data;
+		out.m_Count = static_cast<size_t>(count);
+		out.m_Flags = flags;
+		out.m_Table = table;
+		out.m_Blob = reinterpret_cast<const char*>(input);
+		out.m_BlobSize = static_cast<size_t>(blobSize);
+		return true;
+	}
+
+	inline size_t SerializedStrings::Offset(size_t index) const
+	{
+		size_t width = (m_Flags & FLAG_WIDEOFFSETS) ? 8 : 4;
+		const uint8_t* bytes = m_Table + index * width;
+		uint64_t offset = 0;
+		for (size_t byte = 0; byte < width; byte++)
+		{
+			offset |= static_cast<uint64_t>(bytes[byte]) << (8 * byte);
+		}
+		return static_cast<size_t>(offset);
+	}
+
+	inline String SerializedStrings::Get(size_t index) const
+	{
+#ifndef JHT_STRING_NOASSERT
+		assert(index < m_Count && "Index invalid!");
+#endif
+		if (IsIndexed())
+		{
+			size_t begin = Offset(index);
+			size_t end = index + 1 < m_Count ? Offset(index + 1) : m_BlobSize;
+			return String(m_Blob + begin, end - begin);
+		}
+		const uint8_t* table = m_Table;
+		size_t offset = 0;
+		for (size_t skipped = 0; skipped < index; skipped++)
+		{
+			offset += static_cast<size_t>(varint::DecodeUnchecked(table));
+		}
+		return String(m_Blob + offset, static_cast<size_t>(varint::DecodeUnchecked(table)));
+	}
+
+	inline void SerializedStrings::ReadAll(std::vector<String>& out) const
+	{
+		out.reserve(out.size() + m_Count);
+		JHT_ITERATE(SerializedStrings, *this, iter)
+		{
+			out.push_back(*iter);
+		}
+	}
+
+	inline void SerializedStrings::ReadPairs(std::vector<std::pair<String, String>>& out) const
+	{
+		out.reserve(out.size() + m_Count / 2);
+		for (Iterator iter(*this); iter; ++iter)
+		{
+			String key = *iter;
+			++iter;
+			out.emplace_back(key, *iter);
+		}
+	}
+
+	inline bool TryDeserializeStrings(const String& data, std::vector<String>& out)
+	{
+		SerializedStrings serialized;
+		if (!SerializedStrings::TryOpen(data, serialized))
+		{
+			return false;
+		}
+		serialized.ReadAll(out);
+		return true;
+	}
+
+#pragma endregion
+#pragma region Iterator
+
+	inline SerializedStrings::Iterator::Iterator(const SerializedStrings& source)
+		: m_Source(&source), m_Index(0), m_Table(source.m_Table), m_Offset(0), m_Current()
+	{
+		if (m_Index < m_Source->m_Count)
+		{
+			Decode();
+		}
+	}
+
+	inline void SerializedStrings::Iterator::Decode()
+	{
+		size_t length = 0;
+		if (m_Source->IsIndexed())
+		{
+			length = (m_Index + 1 < m_Source->m_Count ? m_Source->Offset(m_Index + 1) : m_Source->m_BlobSize) - m_Offset;
+		}
+		else
+		{
+			length = static_cast<size_t>(varint::DecodeUnchecked(m_Table));
+		}
+		m_Current = String(m_Source->m_Blob + m_Offset, length);
+	}
+
+	inline void SerializedStrings::Iterator::operator++()
+	{
+		m_Offset += m_Current.Length();
+		m_Index++;
+		if (m_Index < m_Source->m_Count)
+		{
+			Decode();
+		}
+	}
+
+#pragma endregion
+}
\ No newline at end of file
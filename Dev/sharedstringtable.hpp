@@ -0,0 +1,74 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include <string_view>
+#include "string.hpp"
+
+namespace jht {
+
+	/// @brief Read-only string table living in a named shared memory segment, attachable by any process
+	/// @details The segment only stores offsets relative to its own start, so every process can map it at any address.
+	/// Strings returned by Get and Find are views into the mapping and stay valid as long as the table is attached.
+	/// Segments are created by SharedStringTableBuilder::TryPublish. On POSIX systems they persist until Remove is called,
+	/// on Windows they are freed once no process holds them anymore.
+	class SharedStringTable
+	{
+	private:
+		const uint8_t* m_Base;
+		size_t m_Size;
+		void* m_Handle;  // mapping handle, only used on Windows
+
+		bool TryValidate();
+
+	public:
+		SharedStringTable() : m_Base(nullptr), m_Size(0), m_Handle(nullptr) {}
+		~SharedStringTable();
+		SharedStringTable(const SharedStringTable&) = delete;
+		SharedStringTable& operator=(const SharedStringTable&) = delete;
+		SharedStringTable(SharedStringTable&& other) noexcept;
+		SharedStringTable& operator=(SharedStringTable&& other) noexcept;
+
+		/// @brief Maps a published segment read-only
+		/// @param name name of the segment. Use a leading '/' for portability
+		/// @return false if no valid, fully published segment of that name exists
+		static bool TryAttach(const String& name, SharedStringTable& out);
+		/// @brief Removes the name of a segment, processes already attached keep their mapping
+		/// @return false if the segment could not be removed
+		static bool Remove(const String& name);
+		/// @brief Unmaps the segment
+		void Detach();
+
+		/// @brief True if a segment is attached
+		bool IsAttached() const { return m_Base != nullptr; }
+		/// @brief Count of stored strings
+		size_t Count() const;
+		/// @brief Size of the mapped segment in bytes
+		size_t SegmentSize() const { return m_Size; }
+		/// @brief Returns a view of the string with the given id
+		String Get(size_t id) const;
+		/// @brief Looks up the id of a string
+		/// @return true if the string is stored
+		bool Find(const String& value, size_t& id) const;
+	};
+
+	/// @brief Collects unique strings and publishes them as a SharedStringTable
+	class SharedStringTableBuilder
+	{
+	private:
+		std::vector<String> m_Strings;
+		std::unordered_map<std::string_view, size_t> m_Ids;
+
+	public:
+		/// @brief Adds a string. Views have to stay valid until the table is published
+		/// @return the id of the string, strings added before keep their id
+		size_t Add(const String& value);
+		/// @brief Count of unique strings
+		size_t Count() const { return m_Strings.size(); }
+
+		/// @brief Writes the strings into a new shared memory segment and attaches out to it
+		/// @details Readers can only attach once the segment is completely written
+		/// @param name name of the segment. Use a leading '/' for portability
+		/// @return false if a segment of that name already exists or the segment could not be created
+		bool TryPublish(const String& name, SharedStringTable& out) const;
+	};
+}
\ No newline at end of file
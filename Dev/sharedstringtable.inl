@@ -0,0 +1,363 @@
+#pragma once
+#include "sharedstringtable.hpp"
+#include <atomic>
+#include <cassert>
+#include <new>
+#include <string>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace jht
+{
+	namespace sharedstringtable
+	{
+		const uint64_t MAGIC = 0x31544853544A484Aull;  // "JHJTSHT1"
+		const uint32_t EMPTYBUCKET = 0;
+
+		/// @brief Start of every segment. All offsets are relative to the segment start
+		struct Header
+		{
+			std::atomic<uint64_t> Magic;  // written last, a segment is published once it is set
+			uint64_t Size;
+			uint64_t Count;
+			uint64_t BucketCount;
+			uint64_t EntriesOffset;
+			uint64_t BucketsOffset;
+			uint64_t StringsOffset;
+		};
+
+		struct Entry
+		{
+			uint64_t Offset;
+			uint64_t Length;
+			uint64_t Hash;
+		};
+
+		inline uint64_t Align(uint64_t value)
+		{
+			return (value + 7) & ~uint64_t(7);
+		}
+
+		/// @brief Maps a named segment, creating it with the given size if size is not 0
+		/// @return base address or nullptr
+		inline uint8_t* Map(const String& name, size_t& size, void*& handle)
+		{
+			std::string path(name.ConstData(), name.Length());
+			bool create = size != 0;
+#ifdef _WIN32
+			if (create)
+			{
+				handle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD>(uint64_t(size) >> 32), static_cast<DWORD>(size), path.c_str());
+				if (handle && GetLastError() == ERROR_ALREADY_EXISTS)
+				{
+					CloseHandle(handle);
+					handle = nullptr;
+				}
+			}
+			else
+			{
+				handle = OpenFileMappingA(FILE_MAP_READ, FALSE, path.c_str());
+			}
+			if (!handle)
+			{
+				return nullptr;
+			}
+			void* base = MapViewOfFile(handle, create ? FILE_MAP_WRITE : FILE_MAP_READ, 0, 0, create ? size : 0);
+			MEMORY_BASIC_INFORMATION info;
+			if (!base || !VirtualQuery(base, &info, sizeof(info)))
+			{
+				if (base)
+				{
+					UnmapViewOfFile(base);
+				}
+				CloseHandle(handle);
+				handle = nullptr;
+				return nullptr;
+			}
+			size = create ? size : info.RegionSize;
+			return static_cast<uint8_t*>(base);
+#else
+			handle = nullptr;
+			int descriptor = create ? shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0644) : shm_open(path.c_str(), O_RDONLY, 0);
+			if (descriptor < 0)
+			{
+				return nullptr;
+			}
+			struct stat status;
+			if ((create && ftruncate(descriptor, static_cast<off_t>(size)) != 0) || fstat(descriptor, &status) != 0 || status.st_size <= 0)
+			{
+				close(descriptor);
+				if (create)
+				{
+					shm_unlink(path.c_str());
+				}
+				return nullptr;
+			}
+			size = static_cast<size_t>(status.st_size);
+			void* base = mmap(nullptr, size, create ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, descriptor, 0);
+			close(descriptor);
+			if (base == MAP_FAILED)
+			{
+				if (create)
+				{
+					shm_unlink(path.c_str());
+				}
+				return nullptr;
+			}
+			return static_cast<uint8_t*>(base);
+#endif
+		}
+
+		inline void Unmap(const uint8_t* base, [[maybe_unused]] size_t size, [[maybe_unused]] void* handle)
+		{
+#ifdef _WIN32
+			UnmapViewOfFile(base);
+			CloseHandle(handle);
+#else
+			munmap(const_cast<uint8_t*>(base), size);
+#endif
+		}
+	}
+
+#pragma region SharedStringTable
+
+	inline SharedStringTable::~SharedStringTable()
+	{
+		Detach();
+	}
+
+	inline SharedStringTable::SharedStringTable(SharedStringTable&& other) noexcept
+		: m_Base(other.m_Base), m_Size(other.m_Size), m_Handle(other.m_Handle)
+	{
+		other.m_Base = nullptr;
+		other.m_Size = 0;
+		other.m_Handle = nullptr;
+	}
+
+	inline SharedStringTable& SharedStringTable::operator=(SharedStringTable&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Detach();
+			m_Base = other.m_Base;
+			m_Size = other.m_Size;
+			m_Handle = other.m_Handle;
+			other.m_Base = nullptr;
+			other.m_Size = 0;
+			other.m_Handle = nullptr;
+		}
+		return *this;
+	}
+
+	inline void SharedStringTable::Detach()
+	{
+		if (m_Base)
+		{
+			sharedstringtable::Unmap(m_Base, m_Size, m_Handle);
+		}
+		m_Base = nullptr;
+		m_Size = 0;
+		m_Handle = nullptr;
+	}
+
+	inline bool SharedStringTable::TryValidate()
+	{
+		using namespace sharedstringtable;
+		if (m_Size < sizeof(Header))
+		{
+			return false;
+		}
+		const Header& header = *reinterpret_cast<const Header*>(m_Base);
+		if (header.Magic.load(std::memory_order_acquire) != MAGIC || header.Size > m_Size)
+		{
+			return false;
+		}
+		// Entries and strings are trusted once the header describes a consistent layout
+		uint64_t bucketCount = header.BucketCount;
+		if (header.EntriesOffset < sizeof(Header) || header.EntriesOffset > header.Size
+			|| header.Count > (header.Size - header.EntriesOffset) / sizeof(Entry))
+		{
+			return false;
+		}
+		if (header.BucketsOffset < header.EntriesOffset + header.Count * sizeof(Entry) || header.BucketsOffset > header.Size
+			|| bucketCount <= header.Count || (bucketCount & (bucketCount - 1)) != 0 || bucketCount > (header.Size - header.BucketsOffset) / sizeof(uint32_t))
+		{
+			return false;
+		}
+		return header.StringsOffset >= header.BucketsOffset + bucketCount * sizeof(uint32_t) && header.StringsOffset <= header.Size;
+	}
+
+	inline bool SharedStringTable::TryAttach(const String& name, SharedStringTable& out)
+	{
+		out.Detach();
+		size_t size = 0;
+		void* handle = nullptr;
+		const uint8_t* base = sharedstringtable::Map(name, size, handle);
+		if (!base)
+		{
+			return false;
+		}
+		out.m_Base = base;
+		out.m_Size = size;
+		out.m_Handle = handle;
+		if (!out.TryValidate())
+		{
+			out.Detach();
+			return false;
+		}
+		return true;
+	}
+
+	inline bool SharedStringTable::Remove(const String& name)
+	{
+#ifdef _WIN32
+		return true;
+#else
+		std::string path(name.ConstData(), name.Length());
+		return shm_unlink(path.c_str()) == 0;
+#endif
+	}
+
+	inline size_t SharedStringTable::Count() const
+	{
+		if (!m_Base)
+		{
+			return 0;
+		}
+		return static_cast<size_t>(reinterpret_cast<const sharedstringtable::Header*>(m_Base)->Count);
+	}
+
+	inline String SharedStringTable::Get(size_t id) const
+	{
+#ifndef JHT_STRING_NOASSERT
+		assert(id < Count() && "Id invalid!");
+#endif
+		const sharedstringtable::Header& header = *reinterpret_cast<const sharedstringtable::Header*>(m_Base);
+		const sharedstringtable::Entry& entry = reinterpret_cast<const sharedstringtable::Entry*>(m_Base + header.EntriesOffset)[id];
+		return String(reinterpret_cast<const char*>(m_Base + entry.Offset), static_cast<size_t>(entry.Length));
+	}
+
+	inline bool SharedStringTable::Find(const String& value, size_t& id) const
+	{
+		if (!m_Base)
+		{
+			return false;
+		}
+		const sharedstringtable::Header& header = *reinterpret_cast<const sharedstringtable::Header*>(m_Base);
+		const sharedstringtable::Entry* entries = reinterpret_cast<const sharedstringtable::Entry*>(m_Base + header.EntriesOffset);
+		const uint32_t* buckets = reinterpret_cast<const uint32_t*>(m_Base + header.BucketsOffset);
+		uint64_t hash = value.Hash();
+		uint64_t mask = header.BucketCount - 1;
+		for (uint64_t bucket = hash & mask;; bucket = (bucket + 1) & mask)
+		{
+			uint32_t slot = buckets[bucket];
+			if (slot == sharedstringtable::EMPTYBUCKET)
+			{
+				return false;
+			}
+			const sharedstringtable::Entry& entry = entries[slot - 1];
+			if (entry.Hash == hash && entry.Length == value.Length() && memcmp(m_Base + entry.Offset, value.ConstData(), value.Length()) == 0)
+			{
+				id = slot - 1;
+				return true;
+			}
+		}
+	}
+
+#pragma endregion
+#pragma region SharedStringTableBuilder
+
+	inline size_t SharedStringTableBuilder::Add(const String& value)
+	{
+		auto found = m_Ids.find(std::string_view(value.ConstData(), value.Length()));
+		if (found != m_Ids.end())
+		{
+			return found->second;
+		}
+		size_t id = m_Strings.size();
+		m_Strings.push_back(value);
+		m_Ids.emplace(std::string_view(value.ConstData(), value.Length()), id);
+		return id;
+	}
+
+	inline bool SharedStringTableBuilder::TryPublish(const String& name, SharedStringTable& out) const
+	{
+		using namespace sharedstringtable;
+		out.Detach();
+		if (m_Strings.size() >= UINT32_MAX / 2)
+		{
+			return false;
+		}
+
+		// Layout: header, entries, hash buckets (entry index + 1, linear probing), null-terminated string data
+		uint64_t bucketCount = 1;
+		while (bucketCount < m_Strings.size() * 2 + 1)
+		{
+			bucketCount <<= 1;
+		}
+		uint64_t entriesOffset = Align(sizeof(Header));
+		uint64_t bucketsOffset = Align(entriesOffset + m_Strings.size() * sizeof(Entry));
+		uint64_t stringsOffset = Align(bucketsOffset + bucketCount * sizeof(uint32_t));
+		uint64_t totalSize = stringsOffset;
+		for (const String& value : m_Strings)
+		{
+			totalSize += value.Length() + 1;
+		}
+
+		size_t size = static_cast<size_t>(totalSize);
+		void* handle = nullptr;
+		uint8_t* base = Map(name, size, handle);
+		if (!base)
+		{
+			return false;
+		}
+
+		Entry* entries = reinterpret_cast<Entry*>(base + entriesOffset);
+		uint32_t* buckets = reinterpret_cast<uint32_t*>(base + bucketsOffset);
+		memset(buckets, 0, static_cast<size_t>(bucketCount * sizeof(uint32_t)));
+		uint64_t offset = stringsOffset;
+		for (size_t id = 0; id < m_Strings.size(); id++)
+		{
+			const String& value = m_Strings[id];
+			memcpy(base + offset, value.ConstData(), value.Length());
+			base[offset + value.Length()] = 0;
+			entries[id] = { offset, value.Length(), value.Hash() };
+			offset += value.Length() + 1;
+
+			uint64_t bucket = entries[id].Hash & (bucketCount - 1);
+			while (buckets[bucket] != EMPTYBUCKET)
+			{
+				bucket = (bucket + 1) & (bucketCount - 1);
+			}
+			buckets[bucket] = static_cast<uint32_t>(id + 1);
+		}
+
+		Header* header = new (base) Header();
+		header->Size = totalSize;
+		header->Count = m_Strings.size();
+		header->BucketCount = bucketCount;
+		header->EntriesOffset = entriesOffset;
+		header->BucketsOffset = bucketsOffset;
+		header->StringsOffset = stringsOffset;
+		header->Magic.store(MAGIC, std::memory_order_release);
+
+		// Attach read-only, the writable mapping is only needed for publishing
+		bool attached = SharedStringTable::TryAttach(name, out);
+		Unmap(base, size, handle);
+		return attached;
+	}
+
+#pragma endregion
+}
\ No newline at end of file
@@ -1,6 +1,6 @@
 #pragma once
 #include "streams.hpp"
-#include "stringbuilder.hpp"
+#include "stringbuilderpool.hpp"
 
 namespace jht {
 	std::ostream& jht::operator<<(std::ostream& left, const String& right)
@@ -16,35 +16,12 @@ namespace jht {
 			return String();
 		}
 
-		const size_t strsize = 64;
-		size_t writeindex = 0;
-		StringBuilder builder;
-		String buffer = String::MakeManaged('\0', strsize + 1);
-
-		bool encounteredEnd = false;
-		while (true) {
-			if (!in.good() || in.eof()) {
-				builder.Append(buffer);
-			}
-			while (true)
-			{
-
-				char c;
-				in.read(&c, 1);
-				if (c == '\n')
-				{
-					break;
-				}
-				if (writeindex == strsize)
-				{
-					builder.Append(buffer.MakeCopy());
-					buffer.Fill('\0');
-					writeindex = 0;
-				}
-				buffer.Data()[writeindex] = c;
-				writeindex++;
-			}
+		StringBuilderLease builder;
+		char c;
+		while (in.get(c) && c != '\n')
+		{
+			builder->Append(c);
 		}
-		return buffer;
+		return builder->Build();
 	}
 }
\ No newline at end of file
@@ -7,10 +7,14 @@
 namespace jht {
 
 	class StringIterator;
+	class StringHandle;
 
 	/// @brief A String class combining functionality for efficiently refcounted string instances and readonly stringviews in one class
 	class String
 	{
+		friend class StringHandle;
+		friend class StringBuilder;
+
 	private:
 		static const size_t FLAG_ISMANAGED = size_t(0b1) << (sizeof(size_t) * 8 - 2);
 		static const size_t MASK_FLAGS = size_t(0b1) << (sizeof(size_t) * 8 - 2);
@@ -19,15 +23,16 @@ namespace jht {
 		size_t m_Code;
 		void* m_Data;
 
-		static size_t BuildCodeView(size_t length);
+		static constexpr size_t BuildCodeView(size_t length);
 		static size_t BuildCodeManaged(size_t length);
 
 		struct ManagedData
 		{
 			size_t RefCounter;
+			size_t Length;  // lets StringHandle restore the full String from the data pointer alone
 			char Data;
 
-			ManagedData() : RefCounter(0), Data(0) {}
+			ManagedData(size_t length) : RefCounter(0), Length(length), Data(0) {}
 		};
 		ManagedData& AccessManaged();
 		const ManagedData& AccessManaged() const;
@@ -38,21 +43,23 @@ namespace jht {
 
 		const char* AccessStringView() const;
 		void AssertMutable();
+		/// @brief Shortens a managed string in place, the allocation is kept
+		void ShrinkManaged(size_t length);
 	public:
 		/// @brief the iterator type used to iterate through the collection represented by this class
 		using Iterator = StringIterator;
 
 		/// @brief Initializes as a stringview for zero length string
-		String() : m_Code(0), m_Data(const_cast<char*>("")) {}
+		constexpr String() : m_Code(0), m_Data(const_cast<char*>("")) {}
 		/// @brief Initializes as a stringview
 		/// @param data readonly persistent data the stringview refers to
-		String(const char* data) : m_Code(BuildCodeView(strlen(data))), m_Data(const_cast<char*>(data)) {}
+		constexpr String(const char* data) : m_Code(BuildCodeView(std::char_traits<char>::length(data))), m_Data(const_cast<char*>(data)) {}
 		/// @brief Initializes as a stringview
 		/// @param data readonly persistent data the stringview refers to
 		/// @param len length of the string view
-		String(const char* data, const size_t len) : m_Code(BuildCodeView(len)), m_Data(const_cast<char*>(data)) {}
+		constexpr String(const char* data, const size_t len) : m_Code(BuildCodeView(len)), m_Data(const_cast<char*>(data)) {}
 
-		~String();
+		constexpr ~String();
 		String(const String& other);
 		String(const String&& other) noexcept;
 		String& operator=(const String& other);
@@ -64,7 +71,7 @@ namespace jht {
 		/// @brief True if Length() > 0
 		bool IsNotEmpty() const;
 		/// @brief True if the character data is managed via ref counting
-		bool IsManaged() const;
+		constexpr bool IsManaged() const;
 
 		/// @brief Exposes the raw character memory. The mutable version of this function may only be called on managed String objects! Use String::AsManaged() if you need write access.
 		char* Data();
@@ -105,13 +112,18 @@ namespace jht {
 		/// @brief Returns true if Length() > 0
 		operator bool() const;
 
-		/// @brief Returns true if both strings are lexigraphically equal
-		bool operator==(const String& right);
+		/// @brief Returns true if both strings are lexigraphically equal (length check followed by memcmp)
+		bool operator==(const String& right) const;
 		/// @brief Returns true if both strings are lexigraphically nonequal
-		bool operator!=(const String& right);
+		bool operator!=(const String& right) const;
 		/// @brief Returns the lexigraphical comparison between both strings
 		static int32_t Compare(const String& left, const String& right);
 
+		/// @brief Computes the 64 bit FNV-1a hash of a character sequence. Usable at compile time
+		static constexpr uint64_t Hash(const char* data, size_t length);
+		/// @brief Computes the 64 bit FNV-1a hash of the character sequence
+		uint64_t Hash() const;
+
 		/// @brief Returns true for any whitespace character passed in: Tabulation, Line Feed, Vertical Tab, Form Feed, Carriage Return, Space, NewLine
 		static bool IsWhitespace(char character);
 
@@ -140,4 +152,10 @@ namespace jht {
 		/// @brief Initializes a view of a string_view
 		static String MakeView(const std::string_view& strview);
 	};
+
+	inline namespace literals
+	{
+		/// @brief Makes a stringview of a literal, with the length determined at compile time. Usage: "abc"_js
+		consteval String operator""_js(const char* data, size_t length);
+	}
 }
\ No newline at end of file
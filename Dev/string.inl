@@ -19,7 +19,7 @@ namespace jht {
 	{
 		size_t size = sizeof(ManagedData) + static_cast<size_t>(len);
 		void* rawData = operator new[](size, std::align_val_t{ alignof(ManagedData) });
-		ManagedData* data = new (rawData) ManagedData();
+		ManagedData* data = new (rawData) ManagedData(len);
 		(&(data->Data))[len] = '\0';
 		m_Data = data;
 		m_Code = BuildCodeManaged(len);
@@ -59,10 +59,22 @@ namespace jht {
 #endif
 	}
 
+	inline void String::ShrinkManaged(size_t length)
+	{
+		AssertMutable();
+#ifndef JHT_STRING_NOASSERT
+		assert(length <= Length() && "Length invalid!");
+#endif
+		ManagedData& data = AccessManaged();
+		data.Length = length;
+		(&(data.Data))[length] = '\0';
+		m_Code = BuildCodeManaged(length);
+	}
+
 #pragma endregion
 #pragma region Initializing, Constructing, Destructing
 
-	inline size_t String::BuildCodeView(size_t length)
+	constexpr size_t String::BuildCodeView(size_t length)
 	{
 #ifndef JHT_STRING_NOASSERT
 		assert(length < MASK_LENGTH && "Maximum size exceeded!");
@@ -78,7 +90,7 @@ namespace jht {
 		return FLAG_ISMANAGED | length;
 	}
 
-	inline String::~String()
+	constexpr String::~String()
 	{
 		if (IsManaged())
 		{
@@ -136,7 +148,7 @@ namespace jht {
 	{
 		return Length();
 	}
-	inline bool String::IsManaged() const
+	constexpr bool String::IsManaged() const
 	{
 		return (m_Code & FLAG_ISMANAGED);
 	}
@@ -292,14 +304,36 @@ namespace jht {
 		return Length();
 	}
 
-	inline bool String::operator==(const String& right)
+	inline bool String::operator==(const String& right) const
+	{
+		if (Length() != right.Length())
+		{
+			return false;
+		}
+		const char* leftData = Data();
+		const char* rightData = right.Data();
+		return leftData == rightData || memcmp(leftData, rightData, Length()) == 0;
+	}
+
+	inline bool String::operator!=(const String& right) const
 	{
-		return Compare(*this, right) == 0;
+		return !(*this == right);
 	}
 
-	inline bool String::operator!=(const String& right)
+	constexpr uint64_t String::Hash(const char* data, size_t length)
 	{
-		return Compare(*this, right) != 0;
+		uint64_t hash = 14695981039346656037ull;
+		for (size_t index = 0; index < length; index++)
+		{
+			hash ^= static_cast<uint8_t>(data[index]);
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	inline uint64_t String::Hash() const
+	{
+		return Hash(Data(), Length());
 	}
 
 	inline bool jht::String::IsWhitespace(const char c)
@@ -423,5 +457,16 @@ namespace jht {
 		return String(strview.data(), strview.length());
 	}
 
+#pragma endregion
+#pragma region Literals
+
+	inline namespace literals
+	{
+		consteval String operator""_js(const char* data, size_t length)
+		{
+			return String(data, length);
+		}
+	}
+
 #pragma endregion
 }
\ No newline at end of file
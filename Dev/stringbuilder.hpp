@@ -1,47 +1,170 @@
 #pragma once
 #include <vector>
+#include <ostream>
+#include <string_view>
 #include "string.hpp"
 
 namespace jht {
 	/// @brief Provides functionality to conveniently and efficiently chain strings together
+	/// @details By default short inputs are collected in a small buffer and longer ones are kept as separate sections, which Build() copies together.
+	/// After Reserve() all inputs are copied into a single geometrically growing buffer instead, which Build() hands over without copying.
+	/// With a sink set, the content is written out (scatter-gather, without joining it first) whenever it grows past a threshold.
+	/// The staging buffer size and the section threshold can be configured, or adapted to the observed append sizes at runtime.
 	class StringBuilder
 	{
-	private:
+	public:
+		/// @brief Default size of the staging buffer short inputs are collected in
 		static const size_t BUFFERSIZE = 128;
+		/// @brief Default input length from which inputs are kept as separate sections instead of being copied into the staging buffer
 		static const size_t SINGLETHRESHHOLD = BUFFERSIZE / 4;
+		/// @brief Largest staging buffer the adaptive mode grows to
+		static const size_t MAXADAPTIVEBUFFERSIZE = 64 * 1024;
+		/// @brief Count of append size classes tracked. Class c counts appends shorter than 2^c characters, the last one all longer ones
+		static const size_t SIZECLASSES = 20;
 
+		/// @brief Counters describing the appends a builder received
+		struct Statistics
+		{
+			size_t Appends = 0;
+			size_t AppendedBytes = 0;
+			/// @brief Count of times the staging buffer was copied out into a section
+			size_t Flushes = 0;
+			/// @brief Count of inputs kept as separate sections
+			size_t Sections = 0;
+			/// @brief Distribution of append lengths the adaptive mode learns from. Only tracked by adaptive builders
+			size_t SizeClasses[SIZECLASSES] = {};
+		};
+
+	private:
 		std::vector<String> m_Sections;
 		size_t m_Length;
-		String m_Buffer;
+		String m_Buffer;      // staging buffer, or the contiguous buffer after Reserve()
 		size_t m_BufferIndex;
+		size_t m_SingleThreshold;
+		bool m_Adaptive;
+		Statistics m_Stats;
+		bool m_Contiguous;
+		bool m_BufferShared;  // the contiguous buffer was handed out by Build() and must not be written anymore
+		size_t m_SinkThreshold;
+		int m_SinkFile;
+		std::ostream* m_SinkStream;
+		bool m_SinkFailed;
+		size_t m_SinkRetryLength;  // content length at which a failed sink is written to again
 
 		void FlushBuffer();
+		void FlushAndAdapt(bool overflowed);
+		void Adapt(bool overflowed);
+		void Record(size_t length);
+		void Grow(size_t capacity);
+		void CheckSink() { if (m_Length >= m_SinkThreshold && (!m_SinkFailed || m_Length >= m_SinkRetryLength)) { Flush(); } }
 	public:
-		StringBuilder() : m_Sections(), m_Length(0), m_Buffer(String::MakeManaged('\0', BUFFERSIZE)), m_BufferIndex() {}
+		/// @brief Default content length at which a sink is written to
+		static const size_t DEFAULTSINKTHRESHOLD = 64 * 1024;
+
+		StringBuilder() : StringBuilder(BUFFERSIZE, SINGLETHRESHHOLD) {}
+		/// @param bufferSize size of the staging buffer short inputs are collected in. Large buffers suit many tiny appends
+		/// @param singleThreshold inputs of at least this length are kept as separate sections. Limited to bufferSize
+		/// @param adaptive if true, the staging buffer and threshold grow whenever the buffer runs full, following the observed append sizes
+		StringBuilder(size_t bufferSize, size_t singleThreshold, bool adaptive = false) : m_Sections(), m_Length(0),
+			m_Buffer(String::MakeManaged('\0', max(bufferSize, size_t(1)))), m_BufferIndex(), m_SingleThreshold(min(singleThreshold, max(bufferSize, size_t(1)))),
+			m_Adaptive(adaptive), m_Stats(), m_Contiguous(false), m_BufferShared(false), m_SinkThreshold(SIZE_MAX), m_SinkFile(-1), m_SinkStream(nullptr), m_SinkFailed(false), m_SinkRetryLength(0) {}
 
 		/// @brief Combined length of all string sections currently stored
 		size_t Length() const { return m_Length; }
+		/// @brief Characters the contiguous buffer holds before it grows again. 0 unless Reserve() was called
+		size_t Capacity() const { return m_Contiguous && !m_BufferShared ? m_Buffer.Length() : 0; }
+		/// @brief Switches to a single contiguous buffer (if not done before) and makes room for at least capacity characters in total
+		void Reserve(size_t capacity);
+		/// @brief Removes all content. Allocated memory is kept for reuse, except for a contiguous buffer already handed out by Build()
+		void Clear();
+		/// @brief Current size of the staging buffer
+		size_t BufferSize() const { return m_Contiguous ? 0 : m_Buffer.Length(); }
+		/// @brief Current input length from which inputs are kept as separate sections
+		size_t SingleThreshold() const { return m_SingleThreshold; }
+		/// @brief Counters describing the appends since construction or ResetStats()
+		const Statistics& Stats() const { return m_Stats; }
+		/// @brief Resets the counters. The adaptive mode starts learning anew
+		void ResetStats() { m_Stats = Statistics(); }
 
-		/// @brief Append any value
+		/// @brief Exposes room for up to maxLength characters at the end of the builder. Nothing is appended until CommitWrite() is called
+		/// @param maxLength a length beyond the staging buffer size grows the staging buffer
+		char* AcquireWrite(size_t maxLength);
+		/// @brief Appends the first length characters written to the memory returned by the last AcquireWrite()
+		void CommitWrite(size_t length) { Record(length); m_BufferIndex += length; m_Length += length; CheckSink(); }
+
+		/// @brief Writes the content to a file descriptor whenever it reaches threshold characters, the written content is removed
+		/// @details After a failed write the content is kept, the next automatic write is attempted once another threshold characters were appended
+		void SetSink(int file, size_t threshold = DEFAULTSINKTHRESHOLD);
+		/// @brief Writes the content to a stream whenever it reaches threshold characters, the written content is removed
+		/// @details After a failed write the content is kept, the next automatic write is attempted once another threshold characters were appended
+		void SetSink(std::ostream& stream, size_t threshold = DEFAULTSINKTHRESHOLD);
+		/// @brief Stops writing to the sink. Content not flushed yet stays in the builder
+		void RemoveSink();
+		/// @brief Writes all content to the sink and removes it from the builder. Without a sink or if the write fails, the content is kept
+		/// @return false if there is no sink or the write failed. A successful write resumes automatic writes after earlier failures
+		bool Flush();
+		/// @brief Writes all content to a file descriptor without building it first. The builder is left unchanged
+		/// @return false if writing failed
+		bool WriteTo(int file) const;
+		/// @brief Writes all content to a stream without building it first. The builder is left unchanged
+		/// @return false if writing failed
+		bool WriteTo(std::ostream& stream) const;
+		/// @brief Copies all content to output, which needs room for Length() characters. The builder is left unchanged
+		void CopyTo(char* output) const;
+
+		/// @brief Append an integer, formatted in place
+		/// @param radius Which numeric system to use: 2 = binary, 8 = octal, 10 = decimal, 16 = hexadecimal
+		void AppendInt(int64_t value, int32_t radius = 10);
+		/// @brief Append an unsigned integer, formatted in place
+		/// @param radius Which numeric system to use: 2 = binary, 8 = octal, 10 = decimal, 16 = hexadecimal
+		void AppendUint(uint64_t value, int32_t radius = 10);
+		/// @brief Append an unsigned integer as upper case hexadecimal, formatted in place
+		/// @param minDigits pads the output with leading zeros up to this many digits (at most 16)
+		void AppendHex(uint64_t value, size_t minDigits = 0);
+		/// @brief Append a floating point value formatted like ToString, formatted in place
+		void AppendDouble(double value, int32_t precision = 10);
+		/// @brief Append the shortest decimal that parses back to exactly value, formatted in place
+		void AppendShortest(double value);
+		/// @brief Append the shortest decimal that parses back to exactly value as a float, formatted in place
+		void AppendShortest(float value);
+
+		/// @brief Append a unicode code point, UTF-8 encoded in place. Surrogates and values beyond U+10FFFF are replaced by U+FFFD
+		void AppendCodepoint(char32_t code);
+		/// @brief Append UTF-16 text, UTF-8 encoded in place. Unpaired surrogates are replaced by U+FFFD
+		void AppendUtf16(std::u16string_view text);
+		/// @brief Append UTF-32 text, UTF-8 encoded in place. Invalid code points are replaced by U+FFFD
+		void AppendUtf32(std::u32string_view text);
+
+		/// @brief Append str escaped for use inside a JSON string literal (the enclosing quotes are not added)
+		/// @details Quotes, backslashes and control characters are escaped, runs of other characters are copied in bulk
+		void AppendJsonEscaped(const String& str);
+
+		/// @brief Append length characters of data. Unlike Append, the characters are always copied, so data does not have to outlive the builder
+		void AppendCopy(const char* data, size_t length);
+
+		/// @brief Append a null terminated string
+		void Append(const char* cstr);
+		/// @brief Append a string. Long strings are referenced as sections instead of being copied
+		void Append(const String& str);
+		/// @brief Append a single character
+		void Append(char c);
+		/// @brief Append any value. Arithmetic values and enums are formatted in place, other types through an AppendTo overload
+		/// @details Taken by reference, so containers are written into the builder without being copied first.
+		/// Types without an AppendTo(StringBuilder&, const T&) overload (see appendto::HasAppendTo) fail to compile
 		template<typename T>
-		void Append(T value);
+		void Append(const T& value);
 		/// @brief Append any value. Followed by a newline
 		template<typename T>
-		void AppendLine(T value);
+		void AppendLine(const T& value);
 		/// @brief Append any value
 		template<typename T>
-		StringBuilder& operator<<(T value);
-
-		template<>
-		void Append<const char*>(const char* cstr);
-		template<>
-		void Append<>(String str);
-		template<>
-		void Append<const String&>(const String& str);
-		template<>
-		void Append<char>(char c);
+		StringBuilder& operator<<(const T& value);
 
 		/// @brief Construct a managed string containing all inputs chained
+		/// @details A contiguous buffer at least three quarters full is shortened and returned without copying. Its unused capacity stays
+		/// allocated for the lifetime of the returned String. Emptier buffers are copied to an exact size allocation instead.
+		/// If the only content is a single appended managed String, that String is returned and shares its data like any String copy,
+		/// so writing through Data() of the result also changes the appended String. Use MakeCopy() on the result to get separate data
 		String Build();
 	};
 }
\ No newline at end of file
@@ -1,28 +1,146 @@
 #pragma once
 #include "stringbuilder.hpp"
+#include "tostring.hpp"
+#include "json.hpp"
+#include "appendto.hpp"
+#include <bit>
+#include <cassert>
+#include <type_traits>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <cerrno>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
 
 namespace jht {
-	template<>
-	inline void StringBuilder::Append(const char* cstr)
+	namespace stringbuilder
 	{
-		Append(String::MakeView(cstr));
+		/// @brief Writes length bytes to file, retrying on partial writes
+		inline bool WriteAll(int file, const char* data, size_t length)
+		{
+			while (length > 0)
+			{
+#ifdef _WIN32
+				int written = _write(file, data, static_cast<unsigned int>(min(length, size_t(INT32_MAX))));
+#else
+				ssize_t written = write(file, data, length);
+				if (written < 0 && errno == EINTR) {
+					continue;
+				}
+#endif
+				if (written <= 0) {
+					return false;
+				}
+				data += written;
+				length -= static_cast<size_t>(written);
+			}
+			return true;
+		}
+
+		/// @brief Maximum count of bytes a code point encodes to in UTF-8
+		const size_t MAXUTF8LENGTH = 4;
+
+		/// @brief Writes the UTF-8 encoding of code to output, which needs room for MAXUTF8LENGTH bytes
+		/// @return count of bytes written
+		inline size_t EncodeUtf8(char* output, char32_t code)
+		{
+			if (code < 0x80) {
+				output[0] = static_cast<char>(code);
+				return 1;
+			}
+			if (code < 0x800) {
+				output[0] = static_cast<char>(0xC0 | (code >> 6));
+				output[1] = static_cast<char>(0x80 | (code & 0x3F));
+				return 2;
+			}
+			if ((code >= 0xD800 && code < 0xE000) || code > 0x10FFFF) {
+				code = 0xFFFD;
+			}
+			if (code < 0x10000) {
+				output[0] = static_cast<char>(0xE0 | (code >> 12));
+				output[1] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+				output[2] = static_cast<char>(0x80 | (code & 0x3F));
+				return 3;
+			}
+			output[0] = static_cast<char>(0xF0 | (code >> 18));
+			output[1] = static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+			output[2] = static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+			output[3] = static_cast<char>(0x80 | (code & 0x3F));
+			return 4;
+		}
+
+		/// @brief Reads the code point at index of UTF-16 text and advances index past it
+		/// @return the code point, or an unpaired surrogate as it is (EncodeUtf8 replaces it by U+FFFD)
+		inline char32_t DecodeUtf16(const char16_t* data, size_t length, size_t& index)
+		{
+			char32_t code = data[index++];
+			if ((code & 0xFC00) == 0xD800 && index < length && (data[index] & 0xFC00) == 0xDC00) {
+				code = 0x10000 + ((code - 0xD800) << 10) + (char32_t(data[index]) - 0xDC00);
+				index++;
+			}
+			return code;
+		}
+
+#ifndef _WIN32
+		/// @brief Writes all buffers of vectors to file, retrying on partial writes. vectors are modified
+		inline bool WriteAll(int file, iovec* vectors, size_t count)
+		{
+			while (count > 0)
+			{
+				ssize_t written = writev(file, vectors, static_cast<int>(count));
+				if (written < 0 && errno == EINTR) {
+					continue;
+				}
+				if (written <= 0) {
+					return false;
+				}
+				size_t remaining = static_cast<size_t>(written);
+				while (count > 0 && remaining >= vectors->iov_len)
+				{
+					remaining -= vectors->iov_len;
+					vectors++;
+					count--;
+				}
+				if (count > 0) {
+					vectors->iov_base = static_cast<char*>(vectors->iov_base) + remaining;
+					vectors->iov_len -= remaining;
+				}
+			}
+			return true;
+		}
+#endif
 	}
-	template<>
-	inline void StringBuilder::Append(String str)
+
+	inline void StringBuilder::Append(const char* cstr)
 	{
-		Append<const String&>(str);
+		Append(String::MakeView(cstr));
 	}
-	template<>
-	inline void jht::StringBuilder::Append(const String& str)
+
+	inline void StringBuilder::Append(const String& str)
 	{
-		bool pushOnTempBuff = str.Length() < SINGLETHRESHHOLD;
-		bool flushTempBuff = true;
-		if (pushOnTempBuff) {
-			flushTempBuff = str.Length() + m_BufferIndex > BUFFERSIZE;
+		Record(str.Length());
+		if (m_Contiguous)
+		{
+			size_t length = str.Length();
+			if (m_BufferShared || m_BufferIndex + length > m_Buffer.Length())
+			{
+				Grow(m_BufferIndex + length);
+			}
+			memcpy(m_Buffer.Data() + m_BufferIndex, str.ConstData(), length);
+			m_BufferIndex += length;
+			m_Length += length;
+			CheckSink();
+			return;
 		}
 
-		if (flushTempBuff) {
-			FlushBuffer();
+		bool pushOnTempBuff = str.Length() < m_SingleThreshold;
+		if (!pushOnTempBuff) {
+			FlushAndAdapt(false);
+		}
+		else if (str.Length() + m_BufferIndex > m_Buffer.Length()) {
+			FlushAndAdapt(true);
 		}
 
 		m_Length += str.Length();
@@ -33,34 +151,276 @@ namespace jht {
 		}
 		else {
 			m_Sections.push_back(str);
+			m_Stats.Sections++;
 		}
+		CheckSink();
 	}
 
-	template<>
 	inline void StringBuilder::Append(char c)
 	{
-		if (m_BufferIndex >= BUFFERSIZE) {
-			FlushBuffer();
+		Record(1);
+		if (m_Contiguous) {
+			if (m_BufferShared || m_BufferIndex >= m_Buffer.Length()) {
+				Grow(m_BufferIndex + 1);
+			}
+		}
+		else if (m_BufferIndex >= m_Buffer.Length()) {
+			FlushAndAdapt(true);
 		}
 		m_Buffer[m_BufferIndex] = c;
 		m_BufferIndex++;
 		m_Length++;
+		CheckSink();
 	}
 
 	template<typename T>
-	inline void StringBuilder::Append(T value)
+	inline void StringBuilder::Append(const T& value)
+	{
+		if constexpr ((std::is_array<T>::value || std::is_pointer<T>::value) && std::is_same<std::remove_cv_t<std::remove_pointer_t<std::decay_t<T>>>, char>::value)
+		{
+			// Char arrays and non-const char pointers are text, like const char*
+			Append(static_cast<const char*>(value));
+		}
+		else if constexpr (std::is_same<T, bool>::value)
+		{
+			Append(ToString(value));
+		}
+		else if constexpr (std::is_integral<T>::value)
+		{
+			CommitWrite(ToChars(AcquireWrite(tochars::MAXDECIMALLENGTH<T>), value));
+		}
+		else if constexpr (std::is_floating_point<T>::value)
+		{
+			AppendDouble(static_cast<double>(value));
+		}
+		else if constexpr (std::is_enum<T>::value)
+		{
+			Append(static_cast<std::underlying_type_t<T>>(value));
+		}
+		else if constexpr (std::is_pointer<T>::value)
+		{
+			Append(ToString(static_cast<const void*>(value)));
+		}
+		else
+		{
+			static_assert(appendto::HasAppendTo<T>::value, "No overload available for this type! Declare AppendTo(jht::StringBuilder&, const T&) in its namespace");
+			AppendTo(*this, value);
+		}
+	}
+
+	inline char* StringBuilder::AcquireWrite(size_t maxLength)
+	{
+		if (m_Contiguous) {
+			if (m_BufferShared || m_BufferIndex + maxLength > m_Buffer.Length()) {
+				Grow(m_BufferIndex + maxLength);
+			}
+		}
+		else if (m_BufferIndex + maxLength > m_Buffer.Length()) {
+			FlushAndAdapt(true);
+			if (maxLength > m_Buffer.Length()) {
+				m_Buffer = String::MakeManaged(maxLength);
+			}
+		}
+		return m_Buffer.Data() + m_BufferIndex;
+	}
+
+	inline void StringBuilder::AppendInt(int64_t value, int32_t radius)
+	{
+		CommitWrite(ToChars(AcquireWrite(tochars::MaxIntegerLength(radius)), value, radius));
+	}
+
+	inline void StringBuilder::AppendUint(uint64_t value, int32_t radius)
+	{
+		CommitWrite(ToChars(AcquireWrite(tochars::MaxIntegerLength(radius)), value, radius));
+	}
+
+	inline void StringBuilder::AppendHex(uint64_t value, size_t minDigits)
+	{
+		const size_t MAXDIGITS = 16;
+		char* data = AcquireWrite(MAXDIGITS);
+		size_t length = ToChars(data, value, 16);
+		minDigits = min(minDigits, MAXDIGITS);
+		if (length < minDigits)
+		{
+			memmove(data + minDigits - length, data, length);
+			memset(data, '0', minDigits - length);
+			length = minDigits;
+		}
+		CommitWrite(length);
+	}
+
+	inline void StringBuilder::AppendDouble(double value, int32_t precision)
+	{
+		CommitWrite(ToChars(AcquireWrite(tochars::MAXDOUBLELENGTH), value, precision));
+	}
+
+	inline void StringBuilder::AppendShortest(double value)
+	{
+		CommitWrite(ToChars(AcquireWrite(tochars::MAXSHORTESTLENGTH), value));
+	}
+
+	inline void StringBuilder::AppendShortest(float value)
+	{
+		CommitWrite(ToChars(AcquireWrite(tochars::MAXSHORTESTLENGTH), value));
+	}
+
+	inline void StringBuilder::AppendCodepoint(char32_t code)
+	{
+		if (code < 0x80) {
+			Append(static_cast<char>(code));
+			return;
+		}
+		if (!m_Contiguous && BufferSize() < stringbuilder::MAXUTF8LENGTH) {
+			// A staging buffer too small for every encoding is kept, AppendCopy stages the bytes or keeps them as a section
+			char encoded[stringbuilder::MAXUTF8LENGTH];
+			AppendCopy(encoded, stringbuilder::EncodeUtf8(encoded, code));
+			return;
+		}
+		char* output = AcquireWrite(stringbuilder::MAXUTF8LENGTH);
+		CommitWrite(stringbuilder::EncodeUtf8(output, code));
+	}
+
+	inline void StringBuilder::AppendUtf16(std::u16string_view text)
+	{
+		// A unit encodes to at most 3 bytes, a surrogate pair to 4. Blocks are sized to the input and the staging buffer,
+		// one extra byte within the buffer lets a pair straddle the end of a block
+		const size_t MAXBYTESPERUNIT = 3;
+		const char16_t* data = text.data();
+		size_t length = text.length();
+		size_t index = 0;
+		while (index < length)
+		{
+			size_t blockLength = m_Contiguous ? length - index : min(length - index, (BufferSize() - 1) / MAXBYTESPERUNIT);
+			if (blockLength == 0) {
+				AppendCodepoint(stringbuilder::DecodeUtf16(data, length, index));
+				continue;
+			}
+			size_t blockEnd = index + blockLength;
+			char* output = AcquireWrite(blockLength * MAXBYTESPERUNIT + 1);
+			size_t written = 0;
+			while (index < blockEnd)
+			{
+#ifdef JHT_STRING_SSE2
+				// ASCII fast path: narrow 8 units at once as long as none of them has bits above 0x7F
+				if (index + 8 <= blockEnd) {
+					__m128i units = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + index));
+					if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(units, _mm_set1_epi16(static_cast<int16_t>(0xFF80))), _mm_setzero_si128())) == 0xFFFF) {
+						_mm_storel_epi64(reinterpret_cast<__m128i*>(output + written), _mm_packus_epi16(units, units));
+						index += 8;
+						written += 8;
+						continue;
+					}
+				}
+#endif
+				if (data[index] < 0x80) {
+					output[written++] = static_cast<char>(data[index++]);
+					continue;
+				}
+				written += stringbuilder::EncodeUtf8(output + written, stringbuilder::DecodeUtf16(data, length, index));
+			}
+			CommitWrite(written);
+		}
+	}
+
+	inline void StringBuilder::AppendUtf32(std::u32string_view text)
+	{
+		// Blocks are sized to the input and the staging buffer, every code point takes at most MAXUTF8LENGTH bytes
+		const char32_t* data = text.data();
+		size_t length = text.length();
+		size_t index = 0;
+		while (index < length)
+		{
+			size_t blockLength = m_Contiguous ? length - index : min(length - index, BufferSize() / stringbuilder::MAXUTF8LENGTH);
+			if (blockLength == 0) {
+				AppendCodepoint(data[index++]);
+				continue;
+			}
+			size_t blockEnd = index + blockLength;
+			char* output = AcquireWrite(blockLength * stringbuilder::MAXUTF8LENGTH);
+			size_t written = 0;
+			while (index < blockEnd)
+			{
+				char32_t code = data[index++];
+				if (code < 0x80) {
+					output[written++] = static_cast<char>(code);
+				}
+				else {
+					written += stringbuilder::EncodeUtf8(output + written, code);
+				}
+			}
+			CommitWrite(written);
+		}
+	}
+
+	inline void StringBuilder::AppendCopy(const char* data, size_t length)
 	{
-		Append(ToString(value));
+		if (m_Contiguous || length < m_SingleThreshold) {
+			memcpy(AcquireWrite(length), data, length);
+			CommitWrite(length);
+			return;
+		}
+		// Unlike Append, the characters are copied, so data does not have to outlive the builder
+		Record(length);
+		FlushAndAdapt(false);
+		m_Sections.push_back(String::MakeManaged(data, length));
+		m_Stats.Sections++;
+		m_Length += length;
+		CheckSink();
+	}
+
+	inline void StringBuilder::AppendJsonEscaped(const String& str)
+	{
+		const char* data = str.ConstData();
+		size_t length = str.Length();
+		size_t start = 0;
+		while (start < length)
+		{
+			size_t index = start + json::FindEscapeCharacter(data + start, length - start);
+			while (start < index)
+			{
+				// Clean runs fill up the staging buffer in place, so no section is allocated per run
+				size_t room = m_Contiguous ? index - start : BufferSize() - m_BufferIndex;
+				size_t chunk = min(index - start, room > 0 ? room : BufferSize());
+				memcpy(AcquireWrite(chunk), data + start, chunk);
+				CommitWrite(chunk);
+				start += chunk;
+			}
+			if (index == length) {
+				break;
+			}
+
+			const size_t MAXESCAPELENGTH = 6;
+			char* output = AcquireWrite(MAXESCAPELENGTH);
+			uint8_t c = static_cast<uint8_t>(data[index]);
+			output[0] = '\\';
+			switch (c)
+			{
+			case '"': output[1] = '"'; CommitWrite(2); break;
+			case '\\': output[1] = '\\'; CommitWrite(2); break;
+			case '\b': output[1] = 'b'; CommitWrite(2); break;
+			case '\f': output[1] = 'f'; CommitWrite(2); break;
+			case '\n': output[1] = 'n'; CommitWrite(2); break;
+			case '\r': output[1] = 'r'; CommitWrite(2); break;
+			case '\t': output[1] = 't'; CommitWrite(2); break;
+			default:
+				memcpy(output + 1, "u00", 3);
+				output[4] = "0123456789ABCDEF"[c >> 4];
+				output[5] = "0123456789ABCDEF"[c & 0xF];
+				CommitWrite(MAXESCAPELENGTH);
+				break;
+			}
+			start = index + 1;
+		}
 	}
 
 	template<typename T>
-	inline void StringBuilder::AppendLine(T value)
+	inline void StringBuilder::AppendLine(const T& value)
 	{
 		Append(value);
-		Append("\n");
+		Append('\n');
 	}
 	template<typename T>
-	inline StringBuilder& StringBuilder::operator<<(T value)
+	inline StringBuilder& StringBuilder::operator<<(const T& value)
 	{
 		Append(value);
 		return *this;
@@ -71,20 +431,220 @@ namespace jht {
 		if (m_BufferIndex > 0) {
 			m_Sections.push_back(String::MakeManaged(m_Buffer.Data(), m_BufferIndex));
 			m_BufferIndex = 0;
+			m_Stats.Flushes++;
+		}
+	}
+
+	inline void StringBuilder::FlushAndAdapt(bool overflowed)
+	{
+		if (m_BufferIndex == 0) {
+			return;
+		}
+		FlushBuffer();
+		if (m_Adaptive) {
+			Adapt(overflowed);
+		}
+	}
+
+	inline void StringBuilder::Adapt(bool overflowed)
+	{
+		// The threshold becomes the size class covering 90% of the appends, so typical inputs are staged and only outliers become sections.
+		// The staging buffer holds at least 16 typical inputs and doubles whenever it overflows
+		const size_t APPENDSPERBUFFER = 16;
+		size_t covered = m_Stats.SizeClasses[0];
+		size_t sizeClass = 0;
+		while (sizeClass < SIZECLASSES - 1 && covered * 10 < m_Stats.Appends * 9)
+		{
+			sizeClass++;
+			covered += m_Stats.SizeClasses[sizeClass];
+		}
+		size_t threshold = size_t(1) << sizeClass;
+		size_t bufferSize = min(max(m_Buffer.Length() * (overflowed ? 2 : 1), threshold * APPENDSPERBUFFER), size_t(MAXADAPTIVEBUFFERSIZE));
+		if (bufferSize > m_Buffer.Length()) {
+			m_Buffer = String::MakeManaged(bufferSize);
+		}
+		m_SingleThreshold = max(m_SingleThreshold, min(threshold, m_Buffer.Length() / 4));
+	}
+
+	inline void StringBuilder::Record(size_t length)
+	{
+		m_Stats.Appends++;
+		m_Stats.AppendedBytes += length;
+		if (m_Adaptive) {
+			m_Stats.SizeClasses[min(size_t(std::bit_width(length)), SIZECLASSES - 1)]++;
 		}
 	}
 
+	inline void StringBuilder::Grow(size_t capacity)
+	{
+		capacity = max(capacity, max(m_Buffer.Length() * 2, size_t(BUFFERSIZE)));
+		String buffer = String::MakeManaged(capacity);
+		memcpy(buffer.Data(), m_Buffer.ConstData(), m_BufferIndex);
+		m_Buffer = buffer;
+		m_BufferShared = false;
+	}
+
+	inline void StringBuilder::Reserve(size_t capacity)
+	{
+		if (m_Contiguous) {
+			if (m_BufferShared || capacity > m_Buffer.Length()) {
+				Grow(max(capacity, m_BufferIndex));
+			}
+			return;
+		}
+
+		// Move everything collected so far into the new buffer
+		String buffer = String::MakeManaged(max(max(capacity, m_Length), size_t(1)));
+		char* data = buffer.Data();
+		for (const String& section : m_Sections)
+		{
+			memcpy(data, section.ConstData(), section.Length());
+			data += section.Length();
+		}
+		memcpy(data, m_Buffer.ConstData(), m_BufferIndex);
+		m_Sections.clear();
+		m_Buffer = buffer;
+		m_BufferIndex = m_Length;
+		m_Contiguous = true;
+		m_BufferShared = false;
+	}
+
+	inline void StringBuilder::SetSink(int file, size_t threshold)
+	{
+		m_SinkFile = file;
+		m_SinkStream = nullptr;
+		m_SinkThreshold = threshold;
+		m_SinkFailed = false;
+		CheckSink();
+	}
+
+	inline void StringBuilder::SetSink(std::ostream& stream, size_t threshold)
+	{
+		m_SinkFile = -1;
+		m_SinkStream = &stream;
+		m_SinkThreshold = threshold;
+		m_SinkFailed = false;
+		CheckSink();
+	}
+
+	inline void StringBuilder::RemoveSink()
+	{
+		m_SinkFile = -1;
+		m_SinkStream = nullptr;
+		m_SinkThreshold = SIZE_MAX;
+	}
+
+	inline bool StringBuilder::Flush()
+	{
+		// Content is only removed once it was written, so nothing is lost without a sink or when a write fails
+		if (!m_SinkStream && m_SinkFile < 0) {
+			return false;
+		}
+		if (!(m_SinkStream ? WriteTo(*m_SinkStream) : WriteTo(m_SinkFile))) {
+			m_SinkFailed = true;
+			m_SinkRetryLength = m_Length + min(m_SinkThreshold, SIZE_MAX - m_Length);
+			return false;
+		}
+		Clear();
+		m_SinkFailed = false;
+		return true;
+	}
+
+	inline bool StringBuilder::WriteTo(int file) const
+	{
+		if (file < 0) {
+			return false;
+		}
+		if (m_Contiguous) {
+			return stringbuilder::WriteAll(file, m_Buffer.ConstData(), m_BufferIndex);
+		}
+#ifdef _WIN32
+		for (const String& section : m_Sections)
+		{
+			if (!stringbuilder::WriteAll(file, section.ConstData(), section.Length())) {
+				return false;
+			}
+		}
+		return stringbuilder::WriteAll(file, m_Buffer.ConstData(), m_BufferIndex);
+#else
+		// Gather the sections into batches of iovec, the staging buffer is written last
+		const size_t BATCHSIZE = 64;
+		iovec batch[BATCHSIZE];
+		size_t count = 0;
+		for (size_t index = 0; index <= m_Sections.size(); index++)
+		{
+			const String& section = index < m_Sections.size() ? m_Sections[index] : m_Buffer;
+			size_t length = index < m_Sections.size() ? section.Length() : m_BufferIndex;
+			if (length) {
+				batch[count].iov_base = const_cast<char*>(section.ConstData());
+				batch[count].iov_len = length;
+				count++;
+			}
+			if (count == BATCHSIZE || (index == m_Sections.size() && count)) {
+				if (!stringbuilder::WriteAll(file, batch, count)) {
+					return false;
+				}
+				count = 0;
+			}
+		}
+		return true;
+#endif
+	}
+
+	inline bool StringBuilder::WriteTo(std::ostream& stream) const
+	{
+		for (const String& section : m_Sections)
+		{
+			stream.write(section.ConstData(), section.Length());
+		}
+		stream.write(m_Buffer.ConstData(), m_BufferIndex);
+		return static_cast<bool>(stream);
+	}
+
+	inline void StringBuilder::CopyTo(char* output) const
+	{
+		for (const String& section : m_Sections)
+		{
+			memcpy(output, section.ConstData(), section.Length());
+			output += section.Length();
+		}
+		memcpy(output, m_Buffer.ConstData(), m_BufferIndex);
+	}
+
+	inline void StringBuilder::Clear()
+	{
+		m_Sections.clear();
+		m_Length = 0;
+		m_BufferIndex = 0;
+	}
+
 	inline String StringBuilder::Build()
 	{
 		if (m_Length == 0) {
 			return String();
 		}
+		if (m_Contiguous) {
+			// A buffer with more than a quarter unused is copied to an exact fit instead, and stays with the builder for further appends
+			const size_t MAXSLACKDIVISOR = 4;
+			if (!m_BufferShared && (m_Buffer.Length() - m_BufferIndex) * MAXSLACKDIVISOR > m_Buffer.Length()) {
+				return String::MakeManaged(m_Buffer.ConstData(), m_BufferIndex);
+			}
+			if (!m_BufferShared) {
+				m_Buffer.ShrinkManaged(m_BufferIndex);
+				m_BufferShared = true;
+			}
+			return m_Buffer;
+		}
 		FlushBuffer();
+		if (m_Sections.size() == 1 && m_Sections[0].IsManaged()) {
+			// Shared like any String copy, see the doc comment of Build()
+			return m_Sections[0];
+		}
 		String result = String::MakeManaged(Length());
 		char* data = result.Data();
 		for (int32_t index = 0; index < m_Sections.size(); index++)
 		{
-			memcpy(data, m_Sections[index].Data(), m_Sections[index].Length());
+			memcpy(data, m_Sections[index].ConstData(), m_Sections[index].Length());
 			data += m_Sections[index].Length();
 		}
 		return result;
@@ -0,0 +1,49 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include "stringbuilder.hpp"
+
+namespace jht {
+
+	/// @brief Per thread pool of StringBuilder instances, so hot code paths can reuse builders instead of constructing new ones
+	/// @details Prefer StringBuilderLease over calling Acquire and Release directly
+	class StringBuilderPool
+	{
+	private:
+		static std::vector<std::unique_ptr<StringBuilder>>& Pool();
+
+	public:
+		/// @brief Count of idle builders kept per thread
+		static const size_t MAXPOOLED = 8;
+		/// @brief Builders holding a larger contiguous buffer are freed on release instead of pooled
+		static const size_t MAXRETAINEDCAPACITY = 1 << 20;
+
+		/// @brief Takes an empty builder from the pool of the calling thread, or creates one
+		static StringBuilder* Acquire();
+		/// @brief Clears a builder and returns it to the pool of the calling thread
+		/// @details Its sink and statistics are removed and a grown staging buffer is replaced, so the next lease gets a default builder
+		static void Release(StringBuilder* builder);
+		/// @brief Count of idle builders pooled for the calling thread
+		static size_t PooledCount() { return Pool().size(); }
+	};
+
+	/// @brief Scoped access to a pooled StringBuilder, which is cleared and returned to the pool when the lease ends
+	class StringBuilderLease
+	{
+	private:
+		StringBuilder* m_Builder;
+
+	public:
+		StringBuilderLease() : m_Builder(StringBuilderPool::Acquire()) {}
+		~StringBuilderLease() { StringBuilderPool::Release(m_Builder); }
+		StringBuilderLease(const StringBuilderLease&) = delete;
+		StringBuilderLease& operator=(const StringBuilderLease&) = delete;
+
+		/// @brief The leased builder
+		StringBuilder& Get() { return *m_Builder; }
+		/// @brief The leased builder
+		StringBuilder& operator*() { return *m_Builder; }
+		/// @brief The leased builder
+		StringBuilder* operator->() { return m_Builder; }
+	};
+}
\ No newline at end of file
@@ -0,0 +1,41 @@
+#pragma once
+#include "stringbuilderpool.hpp"
+
+namespace jht
+{
+	inline std::vector<std::unique_ptr<StringBuilder>>& StringBuilderPool::Pool()
+	{
+		static thread_local std::vector<std::unique_ptr<StringBuilder>> pool;
+		return pool;
+	}
+
+	inline StringBuilder* StringBuilderPool::Acquire()
+	{
+		std::vector<std::unique_ptr<StringBuilder>>& pool = Pool();
+		if (pool.empty())
+		{
+			return new StringBuilder();
+		}
+		StringBuilder* builder = pool.back().release();
+		pool.pop_back();
+		return builder;
+	}
+
+	inline void StringBuilderPool::Release(StringBuilder* builder)
+	{
+		std::unique_ptr<StringBuilder> owned(builder);
+		std::vector<std::unique_ptr<StringBuilder>>& pool = Pool();
+		if (pool.size() < MAXPOOLED && builder->Capacity() <= MAXRETAINEDCAPACITY)
+		{
+			// The next lease starts from the default configuration. Only a reserved contiguous buffer is kept for reuse
+			if (builder->Capacity() == 0 && (builder->BufferSize() != StringBuilder::BUFFERSIZE || builder->SingleThreshold() != StringBuilder::SINGLETHRESHHOLD))
+			{
+				*builder = StringBuilder();
+			}
+			builder->RemoveSink();
+			builder->ResetStats();
+			builder->Clear();
+			pool.push_back(std::move(owned));
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#pragma once
+#include "string.hpp"
+
+namespace jht {
+
+	/// @brief Single word alternative to String for large collections, converting to and from String without copying
+	/// @details Managed strings are stored as a tagged pointer to their ManagedData, which holds the length. Views keep their length in the
+	/// unused high bits of the pointer, which limits them to MAXVIEWLENGTH characters. Longer views (and views outside the user address range)
+	/// are turned into managed copies on construction. Managed data has to lie within the 48 bit user address range (asserted on construction).
+	/// Like String, handles share managed data by ref counting.
+	class StringHandle
+	{
+	private:
+		static constexpr uint32_t POINTERBITS = sizeof(void*) == 8 ? 48 : 32;
+		static constexpr uint64_t FLAG_ISMANAGED = uint64_t(1) << 63;
+		static constexpr uint64_t MASK_POINTER = (uint64_t(1) << POINTERBITS) - 1;
+
+		uint64_t m_Bits;
+
+		String::ManagedData* AccessManaged() const;
+		String Adopt() const;
+		void Release();
+		void Assign(const String& value);
+
+	public:
+		/// @brief Longest view a handle can refer to without making a managed copy
+		static constexpr size_t MAXVIEWLENGTH = size_t((uint64_t(1) << (63 - POINTERBITS)) - 1);
+
+		/// @brief Initializes as a view of a zero length string
+		StringHandle();
+		/// @brief Refers to the same data as value
+		StringHandle(const String& value);
+		StringHandle(const StringHandle& other);
+		StringHandle(StringHandle&& other) noexcept;
+		StringHandle& operator=(const StringHandle& other);
+		StringHandle& operator=(StringHandle&& other) noexcept;
+		StringHandle& operator=(const String& value);
+		~StringHandle();
+
+		/// @brief Get the length of the character sequence. Managed handles read it from the string data
+		size_t Length() const;
+		/// @brief True if the character data is managed via ref counting
+		bool IsManaged() const { return (m_Bits & FLAG_ISMANAGED) != 0; }
+		/// @brief Exposes the raw character memory
+		const char* ConstData() const;
+		/// @brief Returns a String referring to the same data
+		String ToString() const;
+
+		/// @brief Returns true if both strings are lexigraphically equal
+		bool operator==(const StringHandle& right) const;
+		/// @brief Returns true if both strings are lexigraphically nonequal
+		bool operator!=(const StringHandle& right) const { return !(*this == right); }
+	};
+
+	static_assert(sizeof(StringHandle) == sizeof(uint64_t), "StringHandle must be a single word");
+}
\ No newline at end of file
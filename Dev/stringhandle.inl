@@ -0,0 +1,163 @@
+#pragma once
+#include "stringhandle.hpp"
+#include <cassert>
+
+namespace jht
+{
+#pragma region Internal
+
+	inline String::ManagedData* StringHandle::AccessManaged() const
+	{
+		return reinterpret_cast<String::ManagedData*>(static_cast<uintptr_t>(m_Bits & MASK_POINTER));
+	}
+
+	inline String StringHandle::Adopt() const
+	{
+		// Takes over the reference held by this handle
+		String result;
+		String::ManagedData* data = AccessManaged();
+		result.m_Data = data;
+		result.m_Code = String::BuildCodeManaged(data->Length);
+		return result;
+	}
+
+	inline void StringHandle::Release()
+	{
+		// The adopted String drops the reference when it goes out of scope
+		String adopted = Adopt();
+	}
+
+	inline void StringHandle::Assign(const String& value)
+	{
+		uint64_t pointer = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value.m_Data));
+		if (value.IsManaged())
+		{
+			// Managed data is shared, so there is no copy to fall back to. AccessManaged() only recovers pointers within MASK_POINTER
+#ifndef JHT_STRING_NOASSERT
+			assert((pointer & MASK_POINTER) == pointer && "Managed pointer exceeds the handle's pointer bits!");
+#endif
+			m_Bits = FLAG_ISMANAGED | pointer;
+			AccessManaged()->RefCounter++;
+			return;
+		}
+		if (value.Length() <= MAXVIEWLENGTH && (pointer & MASK_POINTER) == pointer)
+		{
+			m_Bits = (static_cast<uint64_t>(value.Length()) << POINTERBITS) | pointer;
+			return;
+		}
+		Assign(value.MakeCopy());
+	}
+
+#pragma endregion
+#pragma region Construction
+
+	inline StringHandle::StringHandle() : m_Bits(0)
+	{
+		Assign(String());
+	}
+
+	inline StringHandle::StringHandle(const String& value) : m_Bits(0)
+	{
+		Assign(value);
+	}
+
+	inline StringHandle::StringHandle(const StringHandle& other) : m_Bits(other.m_Bits)
+	{
+		if (IsManaged())
+		{
+			AccessManaged()->RefCounter++;
+		}
+	}
+
+	inline StringHandle::StringHandle(StringHandle&& other) noexcept : m_Bits(other.m_Bits)
+	{
+		other.Assign(String());
+	}
+
+	inline StringHandle& StringHandle::operator=(const StringHandle& other)
+	{
+		if (other.IsManaged())
+		{
+			other.AccessManaged()->RefCounter++;
+		}
+		if (IsManaged())
+		{
+			Release();
+		}
+		m_Bits = other.m_Bits;
+		return *this;
+	}
+
+	inline StringHandle& StringHandle::operator=(StringHandle&& other) noexcept
+	{
+		if (this != &other)
+		{
+			if (IsManaged())
+			{
+				Release();
+			}
+			m_Bits = other.m_Bits;
+			other.Assign(String());
+		}
+		return *this;
+	}
+
+	inline StringHandle& StringHandle::operator=(const String& value)
+	{
+		StringHandle previous(std::move(*this));
+		Assign(value);
+		return *this;
+	}
+
+	inline StringHandle::~StringHandle()
+	{
+		if (IsManaged())
+		{
+			Release();
+		}
+	}
+
+#pragma endregion
+#pragma region Access
+
+	inline size_t StringHandle::Length() const
+	{
+		if (IsManaged())
+		{
+			return AccessManaged()->Length;
+		}
+		return static_cast<size_t>((m_Bits & ~FLAG_ISMANAGED) >> POINTERBITS);
+	}
+
+	inline const char* StringHandle::ConstData() const
+	{
+		if (IsManaged())
+		{
+			return &(AccessManaged()->Data);
+		}
+		return reinterpret_cast<const char*>(static_cast<uintptr_t>(m_Bits & MASK_POINTER));
+	}
+
+	inline String StringHandle::ToString() const
+	{
+		if (IsManaged())
+		{
+			String result = Adopt();
+			AccessManaged()->RefCounter++;
+			return result;
+		}
+		return String(ConstData(), Length());
+	}
+
+	inline bool StringHandle::operator==(const StringHandle& right) const
+	{
+		if (m_Bits == right.m_Bits)
+		{
+			return true;
+		}
+		size_t length = Length();
+		return length == right.Length() && memcmp(ConstData(), right.ConstData(), length) == 0;
+	}
+
+#pragma endregion
+}
\ No newline at end of file
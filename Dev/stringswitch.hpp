@@ -0,0 +1,63 @@
+#pragma once
+#include <string_view>
+#include "string.hpp"
+
+namespace jht {
+
+	/// @brief Minimal perfect hash over a fixed set of keywords, usually built at compile time
+	/// @details Keys are hashed once (FNV-1a, mixed with a seed) into a bucket whose displacement picks the slot, so a lookup is one hash,
+	/// one slot probe and one length checked compare. Usage: constexpr StringSwitch methods({ "GET", "POST", "PUT" }); methods.Find(value)
+	template<size_t N>
+	class StringSwitch
+	{
+		static_assert(N > 0 && N < UINT16_MAX, "StringSwitch needs between 1 and 65534 keys");
+
+	private:
+		static constexpr size_t MAXSEEDS = 64;
+		static constexpr size_t MAXDISPLACEMENT = UINT16_MAX;
+
+		std::string_view m_Keys[N];      // ordered by slot
+		uint16_t m_Indices[N];           // index of the key in each slot
+		uint16_t m_Displacements[N];     // per bucket
+		uint64_t m_Seed;
+
+		constexpr uint64_t HashOf(const char* data, size_t length) const;
+		static constexpr size_t Bucket(uint64_t hash) { return static_cast<size_t>(hash >> 32) % N; }
+		static constexpr size_t Slot(uint64_t hash, uint64_t displacement) { return static_cast<size_t>((uint32_t(hash) + displacement * ((hash >> 32) | 1)) % N); }
+		constexpr bool TryBuild(const std::string_view (&keys)[N]);
+
+	public:
+		/// @brief Returned by Find for values that are not a key
+		static constexpr size_t NOTFOUND = SIZE_MAX;
+
+		/// @param keys unique keywords. Their index is what Find returns
+		constexpr StringSwitch(const std::string_view (&keys)[N]);
+
+		/// @brief Count of keys
+		constexpr size_t Count() const { return N; }
+
+		/// @brief Looks up the index of a key
+		/// @return index of the key or NOTFOUND
+		constexpr size_t Find(std::string_view value) const;
+		/// @brief Looks up the index of a key
+		/// @return index of the key or NOTFOUND
+		size_t Find(const String& value) const { return Find(std::string_view(value.ConstData(), value.Length())); }
+		/// @brief Looks up the index of a null-terminated key
+		/// @return index of the key or NOTFOUND
+		constexpr size_t Find(const char* value) const { return Find(std::string_view(value)); }
+		/// @brief Looks up a key and converts its index to TEnum
+		/// @return true if value is a key
+		template<typename TEnum>
+		bool TryFind(const String& value, TEnum& out) const;
+	};
+
+	template<size_t N>
+	StringSwitch(const std::string_view (&)[N]) -> StringSwitch<N>;
+
+	/// @brief Attempts parsing val as one of the keywords of a StringSwitch, the index of the keyword is converted to TEnum
+	/// @param out output value
+	/// @param inject value to return in out if parsing fails
+	/// @return true if val is a keyword
+	template<typename TEnum, size_t N>
+	bool TryParse(const String& val, TEnum& out, const StringSwitch<N>& keywords, TEnum inject = TEnum());
+}
\ No newline at end of file
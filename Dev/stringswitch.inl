@@ -0,0 +1,144 @@
+#pragma once
+#include "stringswitch.hpp"
+#include <cassert>
+
+namespace jht
+{
+	template<size_t N>
+	constexpr uint64_t StringSwitch<N>::HashOf(const char* data, size_t length) const
+	{
+		// FNV-1a alone spreads short keys poorly over the high bits, so it is finalized like splitmix64
+		uint64_t hash = String::Hash(data, length) ^ m_Seed;
+		hash = (hash ^ (hash >> 30)) * 0xBF58476D1CE4E5B9ull;
+		hash = (hash ^ (hash >> 27)) * 0x94D049BB133111EBull;
+		return hash ^ (hash >> 31);
+	}
+
+	template<size_t N>
+	constexpr StringSwitch<N>::StringSwitch(const std::string_view (&keys)[N])
+		: m_Keys(), m_Indices(), m_Displacements(), m_Seed(0)
+	{
+		for (size_t attempt = 0; attempt < MAXSEEDS; attempt++)
+		{
+			m_Seed = attempt * 0x9E3779B97F4A7C15ull;
+			if (TryBuild(keys))
+			{
+				return;
+			}
+		}
+#ifndef JHT_STRING_NOASSERT
+		assert(false && "No perfect hash found, keys must be unique!");
+#endif
+	}
+
+	template<size_t N>
+	constexpr bool StringSwitch<N>::TryBuild(const std::string_view (&keys)[N])
+	{
+		uint64_t hashes[N] = {};
+		size_t bucketStart[N + 1] = {};
+		for (size_t index = 0; index < N; index++)
+		{
+			hashes[index] = HashOf(keys[index].data(), keys[index].size());
+			bucketStart[Bucket(hashes[index]) + 1]++;
+		}
+		for (size_t bucket = 0; bucket < N; bucket++)
+		{
+			bucketStart[bucket + 1] += bucketStart[bucket];
+		}
+		size_t members[N] = {};
+		size_t fill[N] = {};
+		for (size_t index = 0; index < N; index++)
+		{
+			size_t bucket = Bucket(hashes[index]);
+			members[bucketStart[bucket] + fill[bucket]++] = index;
+		}
+
+		// Place the largest buckets first, while most slots are still free
+		size_t order[N] = {};
+		for (size_t bucket = 0; bucket < N; bucket++)
+		{
+			size_t position = bucket;
+			while (position > 0 && fill[order[position - 1]] < fill[bucket])
+			{
+				order[position] = order[position - 1];
+				position--;
+			}
+			order[position] = bucket;
+		}
+
+		bool taken[N] = {};
+		size_t slots[N] = {};
+		for (size_t rank = 0; rank < N && fill[order[rank]]; rank++)
+		{
+			size_t bucket = order[rank];
+			size_t begin = bucketStart[bucket];
+			size_t end = bucketStart[bucket + 1];
+			bool placed = false;
+			for (size_t displacement = 0; displacement <= MAXDISPLACEMENT && !placed; displacement++)
+			{
+				placed = true;
+				for (size_t member = begin; member < end && placed; member++)
+				{
+					slots[member] = Slot(hashes[members[member]], displacement);
+					placed = !taken[slots[member]];
+					for (size_t other = begin; other < member && placed; other++)
+					{
+						placed = slots[other] != slots[member];
+					}
+				}
+				if (placed)
+				{
+					m_Displacements[bucket] = static_cast<uint16_t>(displacement);
+				}
+			}
+			if (!placed)
+			{
+				return false;
+			}
+			for (size_t member = begin; member < end; member++)
+			{
+				taken[slots[member]] = true;
+				m_Keys[slots[member]] = keys[members[member]];
+				m_Indices[slots[member]] = static_cast<uint16_t>(members[member]);
+			}
+		}
+		return true;
+	}
+
+	template<size_t N>
+	constexpr size_t StringSwitch<N>::Find(std::string_view value) const
+	{
+		uint64_t hash = HashOf(value.data(), value.size());
+		size_t slot = Slot(hash, m_Displacements[Bucket(hash)]);
+		const std::string_view& key = m_Keys[slot];
+		if (key.size() == value.size() && std::char_traits<char>::compare(key.data(), value.data(), key.size()) == 0)
+		{
+			return m_Indices[slot];
+		}
+		return NOTFOUND;
+	}
+
+	template<size_t N>
+	template<typename TEnum>
+	bool StringSwitch<N>::TryFind(const String& value, TEnum& out) const
+	{
+		size_t index = Find(value);
+		if (index == NOTFOUND)
+		{
+			return false;
+		}
+		out = static_cast<TEnum>(index);
+		return true;
+	}
+
+	template<typename TEnum, size_t N>
+	bool TryParse(const String& val, TEnum& out, const StringSwitch<N>& keywords, TEnum inject)
+	{
+		if (keywords.TryFind(val.Trimmed(), out))
+		{
+			return true;
+		}
+		out = inject;
+		return false;
+	}
+}
\ No newline at end of file
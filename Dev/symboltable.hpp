@@ -0,0 +1,66 @@
+#pragma once
+#include <vector>
+#include "string.hpp"
+
+namespace jht {
+
+	/// @brief Static symbol table compressor for short strings (FSST style)
+	/// @details A table of up to 255 symbols of 1 to 8 bytes is trained on sample strings. Every symbol is then encoded as a single code byte,
+	/// bytes not covered by any symbol are written as ESCAPE followed by the literal byte. Each string is compressed on its own,
+	/// so any value can be decompressed without touching its neighbours.
+	class SymbolTable
+	{
+	public:
+		/// @brief Maximum count of symbols in a table
+		static constexpr size_t MAXSYMBOLS = 255;
+		/// @brief Maximum length of a single symbol
+		static constexpr size_t MAXSYMBOLLENGTH = 8;
+		/// @brief Code marking that the next byte is stored literally
+		static constexpr uint8_t ESCAPE = 255;
+
+	private:
+		static constexpr size_t TRAININGGENERATIONS = 5;
+		static constexpr size_t TRAININGSAMPLEBYTES = 1 << 15;
+
+		size_t m_Count;
+		uint64_t m_Symbols[MAXSYMBOLS];      // symbol bytes, zero padded
+		uint8_t m_Lengths[MAXSYMBOLS];
+		uint8_t m_Codes[MAXSYMBOLS];         // codes ordered by first byte, longest symbol first
+		uint16_t m_FirstByteStart[257];      // range of m_Codes per first byte
+		uint64_t m_Masks[MAXSYMBOLLENGTH + 1];
+
+		void BuildLookup();
+		size_t LongestMatch(const char* data, size_t remaining, uint8_t& code) const;
+
+	public:
+		/// @brief Creates an empty table that escapes every byte
+		SymbolTable();
+
+		/// @brief Replaces the symbols with ones trained on samples. Only a prefix of the samples up to a fixed byte budget is inspected
+		void Train(const std::vector<String>& samples);
+
+		/// @brief Count of symbols in the table
+		size_t SymbolCount() const { return m_Count; }
+		/// @brief Returns the bytes of the symbol with the given code
+		String Symbol(size_t code) const;
+
+		/// @brief Compresses input to output, which needs room for MaxCompressedLength(input.Length()) bytes
+		/// @return count of bytes written
+		size_t Compress(const String& input, char* output) const;
+		/// @brief Compresses input into a new managed String
+		String Compress(const String& input) const;
+		/// @brief Upper bound of the compressed length of a string with the given length
+		static size_t MaxCompressedLength(size_t length) { return length * 2; }
+
+		/// @brief Length of compressed once decompressed
+		size_t DecompressedLength(const String& compressed) const;
+		/// @brief Decompresses a value produced by Compress with the same table into a new managed String
+		String Decompress(const String& compressed) const;
+
+		/// @brief Serializes the table
+		String Save() const;
+		/// @brief Restores a table serialized with Save
+		/// @return false if data is malformed, the table is left unchanged then
+		bool TryLoad(const String& data);
+	};
+}
\ No newline at end of file
@@ -0,0 +1,393 @@
+#pragma once
+#include "symboltable.hpp"
+#include <algorithm>
+#include <cassert>
+#include <unordered_map>
+
+namespace jht
+{
+	namespace symboltable
+	{
+		struct Candidate
+		{
+			uint64_t Gain;
+			uint64_t Value;
+			uint8_t Length;
+		};
+
+		/// @brief Training works on units: codes of the current table (0 - 254) and literal bytes (256 + byte)
+		const size_t UNITCOUNT = 512;
+		const uint16_t NOUNIT = 0xFFFF;
+	}
+
+#pragma region Construction
+
+	inline SymbolTable::SymbolTable()
+		: m_Count(0), m_Symbols(), m_Lengths(), m_Codes(), m_FirstByteStart(), m_Masks()
+	{
+		BuildLookup();
+	}
+
+	inline void SymbolTable::BuildLookup()
+	{
+		for (size_t length = 0; length <= MAXSYMBOLLENGTH; length++)
+		{
+			uint8_t bytes[MAXSYMBOLLENGTH] = {};
+			memset(bytes, 0xFF, length);
+			memcpy(&m_Masks[length], bytes, MAXSYMBOLLENGTH);
+		}
+
+		// Counting sort of the codes by first byte, longer symbols first so the first hit is the longest match
+		uint16_t counts[257] = {};
+		for (size_t code = 0; code < m_Count; code++)
+		{
+			counts[reinterpret_cast<const uint8_t*>(&m_Symbols[code])[0]]++;
+		}
+		m_FirstByteStart[0] = 0;
+		for (size_t byte = 0; byte < 256; byte++)
+		{
+			m_FirstByteStart[byte + 1] = m_FirstByteStart[byte] + counts[byte];
+		}
+		uint16_t positions[256];
+		memcpy(positions, m_FirstByteStart, sizeof(positions));
+		for (size_t length = MAXSYMBOLLENGTH; length > 0; length--)
+		{
+			for (size_t code = 0; code < m_Count; code++)
+			{
+				if (m_Lengths[code] == length)
+				{
+					m_Codes[positions[reinterpret_cast<const uint8_t*>(&m_Symbols[code])[0]]++] = static_cast<uint8_t>(code);
+				}
+			}
+		}
+	}
+
+	inline void SymbolTable::Train(const std::vector<String>& samples)
+	{
+		m_Count = 0;
+		BuildLookup();
+
+		std::vector<const String*> sample;
+		size_t sampleBytes = 0;
+		for (size_t index = 0; index < samples.size() && sampleBytes < TRAININGSAMPLEBYTES; index++)
+		{
+			sample.push_back(&samples[index]);
+			sampleBytes += samples[index].Length();
+		}
+
+		std::vector<uint32_t> singles(symboltable::UNITCOUNT);
+		std::vector<uint32_t> pairs(symboltable::UNITCOUNT * symboltable::UNITCOUNT);
+		std::vector<symboltable::Candidate> candidates;
+		std::unordered_map<uint64_t, uint64_t> gains[MAXSYMBOLLENGTH + 1];
+
+		for (size_t generation = 0; generation < TRAININGGENERATIONS; generation++)
+		{
+			// Count how often every unit and every pair of adjacent units occurs when compressing with the current table
+			std::fill(singles.begin(), singles.end(), 0);
+			std::fill(pairs.begin(), pairs.end(), 0);
+			for (const String* value : sample)
+			{
+				const char* data = value->ConstData();
+				size_t length = value->Length();
+				uint16_t previous = symboltable::NOUNIT;
+				for (size_t position = 0; position < length;)
+				{
+					uint8_t code = 0;
+					size_t matched = LongestMatch(data + position, length - position, code);
+					uint16_t unit = code;
+					if (!matched)
+					{
+						unit = 256 + static_cast<uint8_t>(data[position]);
+						matched = 1;
+					}
+					singles[unit]++;
+					if (previous != symboltable::NOUNIT)
+					{
+						pairs[previous * symboltable::UNITCOUNT + unit]++;
+					}
+					previous = unit;
+					position += matched;
+				}
+			}
+
+			// Every unit and every concatenation of two units is a candidate for the next table, weighted by the bytes it would cover
+			auto unitBytes = [this](size_t unit, char* bytes) -> size_t
+			{
+				if (unit >= 256)
+				{
+					bytes[0] = static_cast<char>(unit - 256);
+					return 1;
+				}
+				memcpy(bytes, &m_Symbols[unit], MAXSYMBOLLENGTH);
+				return m_Lengths[unit];
+			};
+			for (size_t length = 1; length <= MAXSYMBOLLENGTH; length++)
+			{
+				gains[length].clear();
+			}
+			for (size_t first = 0; first < symboltable::UNITCOUNT; first++)
+			{
+				if (!singles[first])
+				{
+					continue;
+				}
+				char bytes[MAXSYMBOLLENGTH * 2] = {};
+				size_t firstLength = unitBytes(first, bytes);
+				uint64_t value = 0;
+				memcpy(&value, bytes, MAXSYMBOLLENGTH);
+				gains[firstLength][value] += uint64_t(singles[first]) * firstLength;
+				if (firstLength == MAXSYMBOLLENGTH)
+				{
+					continue;
+				}
+				for (size_t second = 0; second < symboltable::UNITCOUNT; second++)
+				{
+					uint32_t count = pairs[first * symboltable::UNITCOUNT + second];
+					if (!count)
+					{
+						continue;
+					}
+					char secondBytes[MAXSYMBOLLENGTH] = {};
+					size_t length = min(firstLength + unitBytes(second, secondBytes), MAXSYMBOLLENGTH);
+					memset(bytes + firstLength, 0, MAXSYMBOLLENGTH);
+					memcpy(bytes + firstLength, secondBytes, length - firstLength);
+					memcpy(&value, bytes, MAXSYMBOLLENGTH);
+					gains[length][value] += uint64_t(count) * length;
+				}
+			}
+
+			// Keep the candidates with the highest gain
+			candidates.clear();
+			for (size_t length = 1; length <= MAXSYMBOLLENGTH; length++)
+			{
+				for (const auto& gain : gains[length])
+				{
+					candidates.push_back({ gain.second, gain.first, static_cast<uint8_t>(length) });
+				}
+			}
+			size_t count = min(candidates.size(), MAXSYMBOLS);
+			std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(),
+				[](const symboltable::Candidate& left, const symboltable::Candidate& right)
+				{
+					if (left.Gain != right.Gain)
+					{
+						return left.Gain > right.Gain;
+					}
+					if (left.Length != right.Length)
+					{
+						return left.Length > right.Length;
+					}
+					return left.Value < right.Value;
+				});
+			for (size_t code = 0; code < count; code++)
+			{
+				m_Symbols[code] = candidates[code].Value;
+				m_Lengths[code] = candidates[code].Length;
+			}
+			m_Count = count;
+			BuildLookup();
+		}
+	}
+
+	inline String SymbolTable::Symbol(size_t code) const
+	{
+#ifndef JHT_STRING_NOASSERT
+		assert(code < m_Count && "Code invalid!");
+#endif
+		return String::MakeManaged(reinterpret_cast<const char*>(&m_Symbols[code]), m_Lengths[code]);
+	}
+
+#pragma endregion
+#pragma region Compression
+
+	inline size_t SymbolTable::LongestMatch(const char* data, size_t remaining, uint8_t& code) const
+	{
+		uint8_t first = static_cast<uint8_t>(data[0]);
+		size_t begin = m_FirstByteStart[first];
+		size_t end = m_FirstByteStart[first + 1];
+		if (begin == end)
+		{
+			return 0;
+		}
+		uint64_t word = 0;
+		memcpy(&word, data, min(remaining, MAXSYMBOLLENGTH));
+		for (size_t index = begin; index < end; index++)
+		{
+			uint8_t candidate = m_Codes[index];
+			size_t length = m_Lengths[candidate];
+			if (length <= remaining && (word & m_Masks[length]) == m_Symbols[candidate])
+			{
+				code = candidate;
+				return length;
+			}
+		}
+		return 0;
+	}
+
+	inline size_t SymbolTable::Compress(const String& input, char* output) const
+	{
+		const char* data = input.ConstData();
+		size_t length = input.Length();
+		size_t written = 0;
+		for (size_t position = 0; position < length;)
+		{
+			uint8_t code = 0;
+			size_t matched = LongestMatch(data + position, length - position, code);
+			if (matched)
+			{
+				output[written++] = static_cast<char>(code);
+				position += matched;
+			}
+			else
+			{
+				output[written++] = static_cast<char>(ESCAPE);
+				output[written++] = data[position++];
+			}
+		}
+		return written;
+	}
+
+	inline String SymbolTable::Compress(const String& input) const
+	{
+		const size_t STACKLENGTH = 256;
+		size_t maxLength = MaxCompressedLength(input.Length());
+		if (maxLength <= STACKLENGTH)
+		{
+			char buffer[STACKLENGTH];
+			return String::MakeManaged(buffer, Compress(input, buffer));
+		}
+		std::vector<char> buffer(maxLength);
+		return String::MakeManaged(buffer.data(), Compress(input, buffer.data()));
+	}
+
+	inline size_t SymbolTable::DecompressedLength(const String& compressed) const
+	{
+		const uint8_t* data = reinterpret_cast<const uint8_t*>(compressed.ConstData());
+		size_t length = compressed.Length();
+		size_t result = 0;
+		for (size_t position = 0; position < length; position++)
+		{
+			uint8_t code = data[position];
+			if (code == ESCAPE)
+			{
+				// A trailing escape without its literal is ignored
+				position++;
+				result += position < length;
+			}
+			else
+			{
+#ifndef JHT_STRING_NOASSERT
+				assert(code < m_Count && "Code invalid!");
+#endif
+				result += m_Lengths[code];
+			}
+		}
+		return result;
+	}
+
+	inline String SymbolTable::Decompress(const String& compressed) const
+	{
+		size_t resultLength = DecompressedLength(compressed);
+		String result = String::MakeManaged(resultLength);
+		if (!resultLength)
+		{
+			return result;
+		}
+
+		const uint8_t* data = reinterpret_cast<const uint8_t*>(compressed.ConstData());
+		size_t length = compressed.Length();
+		char* output = result.Data();
+		char* end = output + resultLength;
+		size_t position = 0;
+
+		// While there is room, whole symbol words are stored and the output advances by the symbol length only
+		while (position < length && output + MAXSYMBOLLENGTH <= end)
+		{
+			uint8_t code = data[position++];
+			if (code == ESCAPE)
+			{
+				*output++ = static_cast<char>(data[position++]);
+			}
+			else
+			{
+				memcpy(output, &m_Symbols[code], MAXSYMBOLLENGTH);
+				output += m_Lengths[code];
+			}
+		}
+		while (position < length && output < end)
+		{
+			uint8_t code = data[position++];
+			if (code == ESCAPE)
+			{
+				if (position == length)
+				{
+					break;
+				}
+				*output++ = static_cast<char>(data[position++]);
+			}
+			else
+			{
+				memcpy(output, &m_Symbols[code], m_Lengths[code]);
+				output += m_Lengths[code];
+			}
+		}
+		return result;
+	}
+
+#pragma endregion
+#pragma region Serialization
+
+	inline String SymbolTable::Save() const
+	{
+		size_t length = 1;
+		for (size_t code = 0; code < m_Count; code++)
+		{
+			length += 1 + m_Lengths[code];
+		}
+		String result = String::MakeManaged(length);
+		char* output = result.Data();
+		*output++ = static_cast<char>(m_Count);
+		for (size_t code = 0; code < m_Count; code++)
+		{
+			*output++ = static_cast<char>(m_Lengths[code]);
+			memcpy(output, &m_Symbols[code], m_Lengths[code]);
+			output += m_Lengths[code];
+		}
+		return result;
+	}
+
+	inline bool SymbolTable::TryLoad(const String& data)
+	{
+		const uint8_t* input = reinterpret_cast<const uint8_t*>(data.ConstData());
+		const uint8_t* end = input + data.Length();
+		if (input == end || *input > MAXSYMBOLS)
+		{
+			return false;
+		}
+		size_t count = *input++;
+		uint64_t symbols[MAXSYMBOLS] = {};
+		uint8_t lengths[MAXSYMBOLS] = {};
+		for (size_t code = 0; code < count; code++)
+		{
+			if (input == end || *input == 0 || *input > MAXSYMBOLLENGTH || static_cast<size_t>(end - input - 1) < *input)
+			{
+				return false;
+			}
+			lengths[code] = *input++;
+			memcpy(&symbols[code], input, lengths[code]);
+			input += lengths[code];
+		}
+		if (input != end)
+		{
+			return false;
+		}
+
+		m_Count = count;
+		memcpy(m_Symbols, symbols, sizeof(symbols));
+		memcpy(m_Lengths, lengths, sizeof(lengths));
+		BuildLookup();
+		return true;
+	}
+
+#pragma endregion
+}
\ No newline at end of file
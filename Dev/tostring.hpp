@@ -1,5 +1,7 @@
 #pragma once
 #include "string.hpp"
+#include <limits>
+#include <type_traits>
 
 namespace jht {
 	/// @brief Stringifies value
@@ -26,4 +28,59 @@ namespace jht {
 	/// @param falsestr set this to customize the string representing 'false'
 	inline String ToString(bool value, const char* truestr = "true", const char* falsestr = "false");
 
-}
+	namespace tochars
+	{
+		/// @brief Maximum count of characters ToChars writes for an integer (64 binary digits plus sign)
+		const size_t MAXINTEGERLENGTH = 65;
+		/// @brief Maximum count of characters ToChars writes for a decimal TInt (digits plus sign)
+		template<typename TInt>
+		constexpr size_t MAXDECIMALLENGTH = size_t(std::numeric_limits<TInt>::digits10 + 1 + (std::is_signed<TInt>::value ? 1 : 0));
+
+		/// @brief Maximum count of characters ToChars writes for a 64 bit integer in radius, so short decimals do not reserve room for 64 binary digits
+		inline size_t MaxIntegerLength(int32_t radius)
+		{
+			switch (radius)
+			{
+			case 10: return MAXDECIMALLENGTH<int64_t>;
+			case 16: return 17;
+			case 8: return 23;
+			default: return MAXINTEGERLENGTH;
+			}
+		}
+		/// @brief Maximum count of characters ToChars writes for a floating point value
+		const size_t MAXDOUBLELENGTH = 56;
+		/// @brief Maximum count of characters the shortest round trip ToChars writes ("-2.2250738585072014e-308")
+		const size_t MAXSHORTESTLENGTH = 25;
+	}
+
+	/// @brief Writes value to buffer without allocating. buffer needs room for tochars::MAXINTEGERLENGTH characters
+	/// @param radius Which numeric system to use: 2 = binary, 8 = octal, 10 = decimal, 16 = hexadecimal
+	/// @return count of characters written
+	inline size_t ToChars(char* buffer, int64_t value, int32_t radius = 10);
+	/// @brief Writes value to buffer without allocating. buffer needs room for tochars::MAXINTEGERLENGTH characters
+	/// @param radius Which numeric system to use: 2 = binary, 8 = octal, 10 = decimal, 16 = hexadecimal
+	/// @return count of characters written
+	inline size_t ToChars(char* buffer, uint64_t value, int32_t radius = 10);
+	/// @brief Writes an integer of any width without allocating. buffer needs room for tochars::MAXINTEGERLENGTH characters
+	/// @details Dispatches on width and signedness at compile time, so narrow types are formatted with 32 bit arithmetic
+	/// @param radius Which numeric system to use: 2 = binary, 8 = octal, 10 = decimal, 16 = hexadecimal
+	/// @return count of characters written
+	template<typename TInt, typename = std::enable_if_t<std::is_integral<TInt>::value && !std::is_same<TInt, bool>::value>>
+	size_t ToChars(char* buffer, TInt value, int32_t radius = 10);
+	/// @brief Writes value to buffer without allocating, formatted like ToString. buffer needs room for tochars::MAXDOUBLELENGTH characters
+	/// @param precision How many letters of the fractional section to include
+	/// @return count of characters written
+	inline size_t ToChars(char* buffer, double value, int32_t precision);
+	/// @brief Writes the shortest decimal that parses back to exactly value. buffer needs room for tochars::MAXSHORTESTLENGTH characters
+	/// @details Plain notation for magnitudes in [1e-6, 1e21), exponent notation ("1.5e+300") beyond. Writes "nan", "inf" and "-inf" for non finite values
+	/// @return count of characters written
+	inline size_t ToChars(char* buffer, double value);
+	/// @brief Writes the shortest decimal that parses back to exactly value as a float. buffer needs room for tochars::MAXSHORTESTLENGTH characters
+	/// @return count of characters written
+	inline size_t ToChars(char* buffer, float value);
+	/// @brief Stringifies value as the shortest decimal that parses back to exactly value
+	inline String ToStringShortest(double value);
+	/// @brief Stringifies value as the shortest decimal that parses back to exactly value as a float
+	inline String ToStringShortest(float value);
+
+}
\ No newline at end of file
@@ -1,29 +1,34 @@
 #pragma once
 #include "tostring.hpp"
+#include "appendto.hpp"
+#include <bit>
 #include <cassert>
-#include "stringbuilder.hpp"
+#include <type_traits>
 
 namespace jht {
 	template<typename TNum>
 	String ToString(TNum value, int32_t arg)
 	{
-		if (std::is_integral<TNum>::value)
+		if constexpr (std::is_integral<TNum>::value)
 		{
-			if (std::is_signed<TNum>::value)
-			{
-				return ToString(static_cast<int64_t>(value), arg);
-			}
-			else
-			{
-				return ToString(static_cast<uint64_t>(value), arg);
-			}
+			char buffer[tochars::MAXINTEGERLENGTH];
+			return String::MakeManaged(buffer, ToChars(buffer, value, arg));
 		}
-		if (std::is_arithmetic<TNum>::value)
+		else if constexpr (std::is_arithmetic<TNum>::value)
 		{
 			return ToString(static_cast<double>(value), arg);
 		}
-		assert(0 && "No overload available for this type!");
-		return String();
+		else if constexpr (std::is_enum<TNum>::value)
+		{
+			return ToString(static_cast<std::underlying_type_t<TNum>>(value), arg);
+		}
+		else
+		{
+			static_assert(appendto::HasAppendTo<TNum>::value, "No overload available for this type! Declare AppendTo(jht::StringBuilder&, const T&) in its namespace");
+			StringBuilder builder;
+			AppendTo(builder, value);
+			return builder.Build();
+		}
 	}
 
 	inline void PrintUint64(char* buffer, int32_t& index, uint64_t value, int32_t radius)
@@ -47,36 +52,125 @@ namespace jht {
 		}
 	}
 
-	template<>
-	inline String ToString(int64_t value, int32_t radius)
+	namespace tochars
 	{
-		const int32_t BUFFERSIZE = 65;  // an unsigned 64 bit integer printed with radius 2 will produce 64 bit values, which is the maximum
+		/// @brief The decimal digits of 00 to 99
+		const char DIGITPAIRS[] =
+			"0001020304050607080910111213141516171819"
+			"2021222324252627282930313233343536373839"
+			"4041424344454647484950515253545556575859"
+			"6061626364656667686970717273747576777879"
+			"8081828384858687888990919293949596979899";
+
+		/// @brief Count of decimal digits of value
+		template<typename TUint>
+		inline size_t DecimalLength(TUint value)
+		{
+			static const uint64_t POWERS[] = { 0, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000, 10000000000ull,
+				100000000000ull, 1000000000000ull, 10000000000000ull, 100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+				100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull };
+			// bit_width * log10(2) estimates the digit count, which is then corrected by one comparison
+			size_t estimate = (static_cast<size_t>(std::bit_width(value | 1)) * 1233) >> 12;
+			return estimate + (value >= POWERS[estimate] ? 1 : 0);
+		}
 
-		char    buffer[BUFFERSIZE] = {};
-		int32_t index = BUFFERSIZE - 2;
+		/// @brief Writes value in decimal, two digits per division
+		template<typename TUint>
+		inline size_t FormatDecimal(char* buffer, TUint value)
+		{
+			size_t length = DecimalLength(value);
+			char* end = buffer + length;
+			while (value >= 100)
+			{
+				size_t pair = static_cast<size_t>(value % 100) * 2;
+				value /= 100;
+				end -= 2;
+				memcpy(end, DIGITPAIRS + pair, 2);
+			}
+			if (value >= 10) {
+				memcpy(end - 2, DIGITPAIRS + static_cast<size_t>(value) * 2, 2);
+			}
+			else {
+				end[-1] = static_cast<char>('0' + value);
+			}
+			return length;
+		}
 
-		bool isneg = value < 0;
-		value = abs(value);
+		/// @brief Writes value in a power of two radix (2^BITS), one shift and mask per digit
+		template<uint32_t BITS, typename TUint>
+		inline size_t FormatPowerOfTwo(char* buffer, TUint value)
+		{
+			const char* NUMLETTERS = "0123456789ABCDEF";
+			size_t length = max((static_cast<size_t>(std::bit_width(value)) + BITS - 1) / BITS, size_t(1));
+			for (size_t index = length; index > 0; index--)
+			{
+				buffer[index - 1] = NUMLETTERS[value & ((TUint(1) << BITS) - 1)];
+				value >>= BITS;
+			}
+			return length;
+		}
 
-		PrintUint64(buffer, index, static_cast<uint64_t>(value), radius);
-		if (isneg)
+		/// @brief Writes value in radix, dispatching to the specialized paths for 10, 16, 8 and 2
+		template<typename TUint>
+		inline size_t FormatUnsigned(char* buffer, TUint value, int32_t radius)
 		{
-			buffer[index] = '-';
-			index--;
+			switch (radius)
+			{
+			case 10: return FormatDecimal(buffer, value);
+			case 16: return FormatPowerOfTwo<4>(buffer, value);
+			case 8: return FormatPowerOfTwo<3>(buffer, value);
+			case 2: return FormatPowerOfTwo<1>(buffer, value);
+			default:
+			{
+				char    digits[MAXINTEGERLENGTH];
+				int32_t index = static_cast<int32_t>(MAXINTEGERLENGTH) - 1;
+				PrintUint64(digits, index, value, radius);
+				size_t length = MAXINTEGERLENGTH - 1 - index;
+				memcpy(buffer, digits + index + 1, length);
+				return length;
+			}
+			}
 		}
-		return String::MakeManaged(buffer + index + 1);
 	}
 
-	template<>
-	inline String ToString(uint64_t value, int32_t radius)
+	template<typename TInt, typename>
+	inline size_t ToChars(char* buffer, TInt value, int32_t radius)
 	{
-		const int32_t BUFFERSIZE = 65;  // an unsigned 64 bit integer printed with radius 2 will produce 64 bit values, which is the maximum
+		// Values up to 32 bits are formatted with 32 bit arithmetic, which divides considerably faster than 64 bit
+		using TUint = std::conditional_t<(sizeof(TInt) <= sizeof(uint32_t)), uint32_t, uint64_t>;
+		if constexpr (std::is_signed<TInt>::value)
+		{
+			if (value < 0)
+			{
+				buffer[0] = '-';
+				return 1 + tochars::FormatUnsigned(buffer + 1, TUint(0) - static_cast<TUint>(value), radius);
+			}
+		}
+		return tochars::FormatUnsigned(buffer, static_cast<TUint>(value), radius);
+	}
 
-		char    buffer[BUFFERSIZE] = {};
-		int32_t index = BUFFERSIZE - 2;
+	inline size_t ToChars(char* buffer, uint64_t value, int32_t radius)
+	{
+		return tochars::FormatUnsigned(buffer, value, radius);
+	}
 
-		PrintUint64(buffer, index, value, radius);
-		return String::MakeManaged(buffer + index + 1);
+	inline size_t ToChars(char* buffer, int64_t value, int32_t radius)
+	{
+		return ToChars<int64_t, void>(buffer, value, radius);
+	}
+
+	template<>
+	inline String ToString(int64_t value, int32_t radius)
+	{
+		char buffer[tochars::MAXINTEGERLENGTH];
+		return String::MakeManaged(buffer, ToChars(buffer, value, radius));
+	}
+
+	template<>
+	inline String ToString(uint64_t value, int32_t radius)
+	{
+		char buffer[tochars::MAXINTEGERLENGTH];
+		return String::MakeManaged(buffer, ToChars(buffer, value, radius));
 	}
 
 	inline String ToString(const void* ptr)
@@ -93,49 +187,48 @@ namespace jht {
 		return String::MakeManaged(buffer, BUFFERSIZE - 1);
 	}
 
-	template<>
-	inline String ToString(double value, int32_t precision)
+	inline size_t ToChars(char* buffer, double value, int32_t precision)
 	{
 		const char* NUMLETTERS = "0123456789ABCDEF";
-		bool isneg = value < 0;  // Keep track of the sign
+		const int32_t MAXPRECISION = 31;
+		const double MAXINTEGRAL = 9223372036854775807.0;
+		if (!(abs(value) < MAXINTEGRAL))  // NaN, infinity and values whose integral part exceeds int64_t
+		{
+			return ToChars(buffer, value);
+		}
+		size_t length = 0;
+		if (value < 0)  // Keep track of the sign
+		{
+			buffer[length++] = '-';
+		}
 
 		int64_t integral = static_cast<int64_t>(value);
-		String integralstr = ToString(abs(integral), 10);
-
-		static const int32_t BUFFERSIZE = 32;
-		char                 buffer[BUFFERSIZE] = {};
-		int32_t              index = 0;
-
-		precision = min(BUFFERSIZE - 1, precision);
+		length += ToChars(buffer + length, static_cast<uint64_t>(abs(integral)), 10);
+		buffer[length++] = '.';
 
+		precision = min(MAXPRECISION, precision);
 		double fract = abs(value - static_cast<double>(integral));  // isolate fractional value
 
-		for (index = 0; index < precision && fract > 0; index++)
+		size_t fractionStart = length;
+		for (int32_t index = 0; index < precision && fract > 0; index++)
 		{
 			fract *= 10;
 			int32_t letter = static_cast<int32_t>(fract);
 			fract = fract - letter;
-			buffer[index] = NUMLETTERS[letter];
-		}
-		String fractionalstr = String(buffer, index);
-
-		StringBuilder builder;
-		if (isneg)
-		{
-			builder << "-";
-		}
-		builder << integralstr;
-		builder << ".";
-		if (index == 0)
-		{
-			builder << "0";
+			buffer[length++] = NUMLETTERS[letter];
 		}
-		else
+		if (length == fractionStart)
 		{
-			builder << fractionalstr;
+			buffer[length++] = '0';
 		}
+		return length;
+	}
 
-		return builder.Build();
+	template<>
+	inline String ToString(double value, int32_t precision)
+	{
+		char buffer[tochars::MAXDOUBLELENGTH];
+		return String::MakeManaged(buffer, ToChars(buffer, value, precision));
 	}
 
 	inline String ToString(bool value, const char* truestr, const char* falsestr)
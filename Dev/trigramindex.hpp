@@ -0,0 +1,58 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+#include "string.hpp"
+
+namespace jht {
+
+	/// @brief Inverted index from byte trigrams to the Strings containing them, answering substring and glob queries
+	/// @details Every trigram owns a posting list of ascending ids, stored as varint encoded deltas. A query intersects the posting lists
+	/// of all trigrams it requires, starting with the shortest one, and verifies the remaining candidates against the actual values.
+	/// Values are stored as passed, views have to stay valid as long as the index is used.
+	class TrigramIndex
+	{
+	private:
+		struct PostingList
+		{
+			std::vector<uint8_t> Data;
+			size_t Count = 0;
+			size_t Last = 0;
+		};
+
+		std::vector<String> m_Values;
+		std::unordered_map<uint32_t, PostingList> m_Postings;
+
+		static void Append(PostingList& list, size_t id);
+		static void ExtractTrigrams(const char* data, size_t length, std::vector<uint32_t>& out);
+		static bool ExtractGlobTrigrams(const String& glob, std::vector<uint32_t>& out);
+		void Candidates(std::vector<uint32_t>& trigrams, std::vector<size_t>& out) const;
+
+	public:
+		/// @brief Minimum count of values per thread for AddRange to build in parallel
+		static const size_t PARALLELTHRESHOLD = 4096;
+
+		/// @brief Count of stored values
+		size_t Count() const { return m_Values.size(); }
+		/// @brief Returns the value stored with id
+		const String& Get(size_t id) const;
+		/// @brief Bytes allocated by the posting lists
+		size_t MemoryUsage() const;
+		/// @brief Removes all values
+		void Clear();
+
+		/// @brief Adds a single value
+		/// @return the id of the value. Ids are assigned consecutively starting at 0
+		size_t Add(const String& value);
+		/// @brief Adds many values, extracting their trigrams on multiple threads. Ids are assigned in the order of values
+		/// @param threadCount count of threads to use, 0 for the hardware concurrency
+		void AddRange(const std::vector<String>& values, size_t threadCount = 0);
+
+		/// @brief Finds all values containing needle
+		/// @param out receives the ascending ids of the matching values
+		void FindContaining(const String& needle, std::vector<size_t>& out) const;
+		/// @brief Finds all values matched by a glob (see Pattern::TryCompileGlob)
+		/// @param out receives the ascending ids of the matching values
+		/// @return false if the glob is invalid
+		bool FindMatching(const String& glob, std::vector<size_t>& out) const;
+	};
+}
\ No newline at end of file
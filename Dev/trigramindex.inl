@@ -0,0 +1,320 @@
+#pragma once
+#include "trigramindex.hpp"
+#include "pattern.hpp"
+#include "varint.hpp"
+#include <algorithm>
+#include <cassert>
+#include <string_view>
+#include <thread>
+
+namespace jht
+{
+	namespace trigramindex
+	{
+		inline uint32_t Trigram(const char* data)
+		{
+			return (uint32_t(uint8_t(data[0])) << 16) | (uint32_t(uint8_t(data[1])) << 8) | uint32_t(uint8_t(data[2]));
+		}
+
+		inline bool Contains(const String& value, const String& needle)
+		{
+			return std::string_view(value.ConstData(), value.Length()).find(std::string_view(needle.ConstData(), needle.Length())) != std::string_view::npos;
+		}
+	}
+
+#pragma region Building
+
+	inline void TrigramIndex::Append(PostingList& list, size_t id)
+	{
+		varint::Append(list.Data, id - list.Last);
+		list.Last = id;
+		list.Count++;
+	}
+
+	inline void TrigramIndex::ExtractTrigrams(const char* data, size_t length, std::vector<uint32_t>& out)
+	{
+		for (size_t index = 0; index + 3 <= length; index++)
+		{
+			out.push_back(trigramindex::Trigram(data + index));
+		}
+	}
+
+	inline const String& TrigramIndex::Get(size_t id) const
+	{
+#ifndef JHT_STRING_NOASSERT
+		assert(id < m_Values.size() && "Id invalid!");
+#endif
+		return m_Values[id];
+	}
+
+	inline size_t TrigramIndex::MemoryUsage() const
+	{
+		size_t result = sizeof(TrigramIndex) + m_Values.capacity() * sizeof(String);
+		for (const auto& posting : m_Postings)
+		{
+			result += sizeof(posting) + posting.second.Data.capacity();
+		}
+		return result;
+	}
+
+	inline void TrigramIndex::Clear()
+	{
+		m_Values.clear();
+		m_Postings.clear();
+	}
+
+	inline size_t TrigramIndex::Add(const String& value)
+	{
+		size_t id = m_Values.size();
+		m_Values.push_back(value);
+
+		std::vector<uint32_t> trigrams;
+		ExtractTrigrams(value.ConstData(), value.Length(), trigrams);
+		std::sort(trigrams.begin(), trigrams.end());
+		trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+		for (uint32_t trigram : trigrams)
+		{
+			Append(m_Postings[trigram], id);
+		}
+		return id;
+	}
+
+	inline void TrigramIndex::AddRange(const std::vector<String>& values, size_t threadCount)
+	{
+		if (threadCount == 0)
+		{
+			threadCount = max(size_t(std::thread::hardware_concurrency()), size_t(1));
+		}
+		threadCount = min(threadCount, max(values.size() / PARALLELTHRESHOLD, size_t(1)));
+		if (threadCount == 1)
+		{
+			m_Values.reserve(m_Values.size() + values.size());
+			for (const String& value : values)
+			{
+				Add(value);
+			}
+			return;
+		}
+
+		// Each thread collects sorted (trigram, local index) pairs of its chunk, the chunks are then merged in order so ids stay ascending
+		size_t baseId = m_Values.size();
+		size_t chunkSize = (values.size() + threadCount - 1) / threadCount;
+		std::vector<std::vector<uint64_t>> chunks(threadCount);
+		std::vector<std::thread> threads;
+		for (size_t thread = 0; thread < threadCount; thread++)
+		{
+			threads.emplace_back([&values, &chunks, chunkSize, thread]()
+			{
+				std::vector<uint64_t>& pairs = chunks[thread];
+				std::vector<uint32_t> trigrams;
+				size_t end = min(values.size(), (thread + 1) * chunkSize);
+				for (size_t index = thread * chunkSize; index < end; index++)
+				{
+					trigrams.clear();
+					ExtractTrigrams(values[index].ConstData(), values[index].Length(), trigrams);
+					for (uint32_t trigram : trigrams)
+					{
+						pairs.push_back((uint64_t(trigram) << 32) | uint64_t(index));
+					}
+				}
+				std::sort(pairs.begin(), pairs.end());
+				pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+			});
+		}
+		for (std::thread& thread : threads)
+		{
+			thread.join();
+		}
+
+		m_Values.insert(m_Values.end(), values.begin(), values.end());
+		for (const std::vector<uint64_t>& pairs : chunks)
+		{
+			PostingList* list = nullptr;
+			uint32_t current = 0;
+			for (size_t index = 0; index < pairs.size(); index++)
+			{
+				uint32_t trigram = static_cast<uint32_t>(pairs[index] >> 32);
+				if (!list || trigram != current)
+				{
+					list = &m_Postings[trigram];
+					current = trigram;
+				}
+				Append(*list, baseId + static_cast<uint32_t>(pairs[index]));
+			}
+		}
+	}
+
+#pragma endregion
+#pragma region Queries
+
+	inline bool TrigramIndex::ExtractGlobTrigrams(const String& glob, std::vector<uint32_t>& out)
+	{
+		// Literal runs outside of wildcards, classes and alternatives have to appear in every match
+		const char* cur = glob.ConstData();
+		const char* end = cur + glob.Length();
+		std::vector<char> run;
+		auto flush = [&run, &out]()
+		{
+			ExtractTrigrams(run.data(), run.size(), out);
+			run.clear();
+		};
+		while (cur < end)
+		{
+			char c = *cur++;
+			switch (c)
+			{
+			case '*':
+			case '?':
+				flush();
+				break;
+			case '[':
+				flush();
+				if (cur < end && (*cur == '!' || *cur == '^'))
+				{
+					cur++;
+				}
+				if (cur < end && *cur == ']')
+				{
+					cur++;
+				}
+				while (cur < end && *cur != ']')
+				{
+					cur += (*cur == '\\' && cur + 1 < end) ? 2 : 1;
+				}
+				if (cur == end)
+				{
+					return false;
+				}
+				cur++;
+				break;
+			case '{':
+			{
+				flush();
+				size_t depth = 1;
+				while (cur < end && depth)
+				{
+					if (*cur == '\\' && cur + 1 < end)
+					{
+						cur++;
+					}
+					else if (*cur == '{')
+					{
+						depth++;
+					}
+					else if (*cur == '}')
+					{
+						depth--;
+					}
+					cur++;
+				}
+				if (depth)
+				{
+					return false;
+				}
+				break;
+			}
+			case '\\':
+				if (cur == end)
+				{
+					return false;
+				}
+				run.push_back(*cur++);
+				break;
+			default:
+				run.push_back(c);
+				break;
+			}
+		}
+		flush();
+		return true;
+	}
+
+	inline void TrigramIndex::Candidates(std::vector<uint32_t>& trigrams, std::vector<size_t>& out) const
+	{
+		out.clear();
+		if (trigrams.empty())
+		{
+			for (size_t id = 0; id < m_Values.size(); id++)
+			{
+				out.push_back(id);
+			}
+			return;
+		}
+
+		std::sort(trigrams.begin(), trigrams.end());
+		trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+		std::vector<const PostingList*> lists;
+		for (uint32_t trigram : trigrams)
+		{
+			auto found = m_Postings.find(trigram);
+			if (found == m_Postings.end())
+			{
+				return;
+			}
+			lists.push_back(&found->second);
+		}
+		std::sort(lists.begin(), lists.end(), [](const PostingList* left, const PostingList* right) { return left->Count < right->Count; });
+
+		// Decode the shortest list, then narrow it down with each further list
+		const uint8_t* data = lists[0]->Data.data();
+		size_t id = 0;
+		for (size_t index = 0; index < lists[0]->Count; index++)
+		{
+			id += static_cast<size_t>(varint::DecodeUnchecked(data));
+			out.push_back(id);
+		}
+		for (size_t list = 1; list < lists.size() && !out.empty(); list++)
+		{
+			data = lists[list]->Data.data();
+			size_t remaining = lists[list]->Count - 1;
+			size_t current = static_cast<size_t>(varint::DecodeUnchecked(data));
+			size_t kept = 0;
+			for (size_t index = 0; index < out.size(); index++)
+			{
+				while (current < out[index] && remaining)
+				{
+					current += static_cast<size_t>(varint::DecodeUnchecked(data));
+					remaining--;
+				}
+				if (current == out[index])
+				{
+					out[kept++] = out[index];
+				}
+				else if (current < out[index])
+				{
+					break;
+				}
+			}
+			out.resize(kept);
+		}
+	}
+
+	inline void TrigramIndex::FindContaining(const String& needle, std::vector<size_t>& out) const
+	{
+		std::vector<uint32_t> trigrams;
+		ExtractTrigrams(needle.ConstData(), needle.Length(), trigrams);
+		Candidates(trigrams, out);
+		if (needle.Length() == 0 || needle.Length() == 3)
+		{
+			// The candidates are exact, a needle of three bytes is its only trigram
+			return;
+		}
+		out.erase(std::remove_if(out.begin(), out.end(), [this, &needle](size_t id) { return !trigramindex::Contains(m_Values[id], needle); }), out.end());
+	}
+
+	inline bool TrigramIndex::FindMatching(const String& glob, std::vector<size_t>& out) const
+	{
+		out.clear();
+		Pattern pattern;
+		std::vector<uint32_t> trigrams;
+		if (!Pattern::TryCompileGlob(glob, pattern) || !ExtractGlobTrigrams(glob, trigrams))
+		{
+			return false;
+		}
+		Candidates(trigrams, out);
+		out.erase(std::remove_if(out.begin(), out.end(), [this, &pattern](size_t id) { return !pattern.Matches(m_Values[id]); }), out.end());
+		return true;
+	}
+
+#pragma endregion
+}
\ No newline at end of file
@@ -192,12 +192,12 @@ namespace jht
 
 	bool TryParse(const String& val, bool& out, bool inject)
 	{
-		if (val.SubString(0, 5) == "false")
+		if (val.SubString(0, 5) == "false"_js)
 		{
 			out = false;
 			return true;
 		}
-		else if (val.SubString(0, 4) == "true")
+		else if (val.SubString(0, 4) == "true"_js)
 		{
 			out = true;
 			return true;
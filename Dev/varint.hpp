@@ -0,0 +1,79 @@
+#pragma once
+#include <vector>
+#include "basics.hpp"
+
+namespace jht
+{
+	/// @brief LEB128 style variable length encoding of unsigned integers (7 bits per byte, high bit marks continuation)
+	namespace varint
+	{
+		/// @brief Maximum count of bytes a 64 bit value encodes to
+		const size_t MAXBYTES = 10;
+
+		/// @brief Count of bytes value encodes to
+		inline size_t Size(uint64_t value)
+		{
+			size_t size = 1;
+			while (value >= 0x80)
+			{
+				value >>= 7;
+				size++;
+			}
+			return size;
+		}
+
+		/// @brief Encodes value to output, which needs room for at least Size(value) bytes
+		/// @return count of bytes written
+		inline size_t Encode(uint64_t value, uint8_t* output)
+		{
+			size_t index = 0;
+			while (value >= 0x80)
+			{
+				output[index++] = static_cast<uint8_t>(value) | 0x80;
+				value >>= 7;
+			}
+			output[index++] = static_cast<uint8_t>(value);
+			return index;
+		}
+
+		/// @brief Appends the encoding of value to output
+		inline void Append(std::vector<uint8_t>& output, uint64_t value)
+		{
+			uint8_t buffer[MAXBYTES];
+			size_t size = Encode(value, buffer);
+			output.insert(output.end(), buffer, buffer + size);
+		}
+
+		/// @brief Decodes a value from input, reading no further than end
+		/// @return count of bytes consumed, 0 if the encoding is truncated or malformed
+		inline size_t Decode(const uint8_t* input, const uint8_t* end, uint64_t& value)
+		{
+			value = 0;
+			for (size_t index = 0; index < MAXBYTES && input + index < end; index++)
+			{
+				uint8_t byte = input[index];
+				value |= static_cast<uint64_t>(byte & 0x7F) << (7 * index);
+				if (!(byte & 0x80))
+				{
+					return index + 1;
+				}
+			}
+			return 0;
+		}
+
+		/// @brief Decodes a value from trusted input and advances input past it
+		inline uint64_t DecodeUnchecked(const uint8_t*& input)
+		{
+			uint64_t value = 0;
+			for (uint32_t shift = 0;; shift += 7)
+			{
+				uint8_t byte = *input++;
+				value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+				if (!(byte & 0x80))
+				{
+					return value;
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
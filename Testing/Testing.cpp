@@ -10,14 +10,55 @@
 #include "test_stringiter.hpp"
 #include "test_tostringparse.hpp"
 #include "test_converter.hpp"
+#include "test_pattern.hpp"
+#include "test_fuzzy.hpp"
+#include "test_radixtree.hpp"
+#include "test_frontcoded.hpp"
+#include "test_symboltable.hpp"
+#include "test_trigramindex.hpp"
+#include "test_stringswitch.hpp"
+#include "test_sharedstringtable.hpp"
+#include "test_stringhandle.hpp"
+#include "test_serialization.hpp"
+#include "test_lineindex.hpp"
+#include "test_stringbuilder.hpp"
+#include "test_inplacestringbuilder.hpp"
+#include "test_join.hpp"
+#include "test_json.hpp"
+#include "test_logger.hpp"
+#include "bench_stringbuilder.hpp"
+#include "bench_tochars.hpp"
 
-int main()
+int main(int argc, char** argv)
 {
 	//_setmode(_fileno(stdout), _O_U16TEXT);
+	if (argc > 1 && std::string(argv[1]) == "--bench")
+	{
+		jht::RunBenchmarks_StringBuilder();
+		jht::RunBenchmarks_ToChars();
+		return 0;
+	}
+
 	jht::RunTests_String();
 	jht::RunTests_StringIterator();
 	jht::RunTests_ToStringParse();
 	jht::RunTests_Converter();
+	jht::RunTests_Pattern();
+	jht::RunTests_Fuzzy();
+	jht::RunTests_RadixTree();
+	jht::RunTests_FrontCoded();
+	jht::RunTests_SymbolTable();
+	jht::RunTests_TrigramIndex();
+	jht::RunTests_StringSwitch();
+	jht::RunTests_SharedStringTable();
+	jht::RunTests_StringHandle();
+	jht::RunTests_Serialization();
+	jht::RunTests_LineIndex();
+	jht::RunTests_StringBuilder();
+	jht::RunTests_InplaceStringBuilder();
+	jht::RunTests_Join();
+	jht::RunTests_Json();
+	jht::RunTests_Logger();
 
 	std::cout << "ALL TESTS PASSED";
 }
@@ -0,0 +1,74 @@
+#pragma once
+#include "jhtstring.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace jht
+{
+	namespace bench
+	{
+		/// @brief Builds the workload repeatedly with builders created by makeBuilder and prints flush counts and throughput
+		template<typename TMake, typename TWorkload>
+		inline void MeasureStringBuilder(const char* name, TMake makeBuilder, TWorkload workload, size_t repetitions)
+		{
+			size_t bytes = 0;
+			size_t checksum = 0;
+			StringBuilder::Statistics stats;
+			auto start = std::chrono::steady_clock::now();
+			for (size_t repetition = 0; repetition < repetitions; repetition++)
+			{
+				StringBuilder builder = makeBuilder();
+				workload(builder);
+				stats = builder.Stats();
+				String result = builder.Build();
+				bytes += result.Length();
+				checksum += static_cast<uint8_t>(result[result.Length() / 2]);
+			}
+			double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+			std::cout << "  " << std::left << std::setw(28) << name << std::right
+				<< " flushes " << std::setw(6) << stats.Flushes
+				<< "  sections " << std::setw(6) << stats.Sections
+				<< "  " << std::fixed << std::setprecision(1) << std::setw(8) << (bytes / seconds / (1024 * 1024)) << " MB/s"
+				<< "  (" << checksum % 10 << ")\n";
+		}
+
+		template<typename TWorkload>
+		inline void CompareStringBuilders(const char* workloadName, TWorkload workload, size_t repetitions)
+		{
+			std::cout << workloadName << "\n";
+			MeasureStringBuilder("default (128 / 32)", []() { return StringBuilder(); }, workload, repetitions);
+			MeasureStringBuilder("configured (4096 / 1024)", []() { return StringBuilder(4096, 1024); }, workload, repetitions);
+			MeasureStringBuilder("adaptive", []() { return StringBuilder(StringBuilder::BUFFERSIZE, StringBuilder::SINGLETHRESHHOLD, true); }, workload, repetitions);
+		}
+	}
+
+	/// @brief Compares the staging buffer configurations of StringBuilder on a workload of tiny appends and one of larger sections
+	inline void RunBenchmarks_StringBuilder()
+	{
+		std::cout << "RunBenchmarks_StringBuilder\n";
+
+		bench::CompareStringBuilders("log formatting: 20000 lines of tiny appends", [](StringBuilder& builder)
+		{
+			for (int32_t line = 0; line < 20000; line++)
+			{
+				builder << "ts=" << 1700000000 + line << " level=" << 'I' << " thread=" << line % 8 << " msg=request done\n";
+			}
+		}, 20);
+
+		std::vector<String> paragraphs;
+		for (size_t index = 0; index < 64; index++)
+		{
+			paragraphs.push_back(String::MakeManaged('x', 40 + index * 31));
+		}
+		bench::CompareStringBuilders("report generation: 20000 paragraphs of 40 to 2000 characters", [&paragraphs](StringBuilder& builder)
+		{
+			for (size_t index = 0; index < 20000; index++)
+			{
+				builder << "<p>" << paragraphs[index % paragraphs.size()] << "</p>\n";
+			}
+		}, 20);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,117 @@
+#pragma once
+#include "jhtstring.hpp"
+#include <bit>
+#include <charconv>
+#include <cstdio>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+namespace jht
+{
+	namespace bench
+	{
+		/// @brief Formats all values with format and prints the time per value
+		template<typename T, typename TFormat>
+		inline void MeasureToChars(const char* name, const std::vector<T>& values, TFormat format)
+		{
+			const size_t REPETITIONS = 20;
+			char buffer[tochars::MAXINTEGERLENGTH];
+			size_t checksum = 0;
+			auto start = std::chrono::steady_clock::now();
+			for (size_t repetition = 0; repetition < REPETITIONS; repetition++)
+			{
+				for (T value : values)
+				{
+					size_t length = format(buffer, value);
+					checksum += length + static_cast<uint8_t>(buffer[0]);
+				}
+			}
+			double nanoseconds = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+			std::cout << "  " << std::left << std::setw(36) << name << std::right << std::fixed << std::setprecision(2)
+				<< std::setw(8) << nanoseconds / (REPETITIONS * values.size()) << " ns  (" << checksum % 10 << ")\n";
+		}
+
+		template<typename T>
+		inline void CompareToChars(const char* name, const std::vector<T>& values, int32_t radius)
+		{
+			std::cout << name << "\n";
+			MeasureToChars("jht::ToChars", values, [radius](char* buffer, T value) { return ToChars(buffer, value, radius); });
+			MeasureToChars("std::to_chars", values, [radius](char* buffer, T value)
+			{
+				return static_cast<size_t>(std::to_chars(buffer, buffer + tochars::MAXINTEGERLENGTH, value, radius).ptr - buffer);
+			});
+			MeasureToChars("one digit per division (previous)", values, [radius](char* buffer, T value)
+			{
+				char    digits[tochars::MAXINTEGERLENGTH];
+				int32_t index = static_cast<int32_t>(tochars::MAXINTEGERLENGTH) - 1;
+				PrintUint64(digits, index, static_cast<uint64_t>(value), radius);
+				size_t length = tochars::MAXINTEGERLENGTH - 1 - index;
+				memcpy(buffer, digits + index + 1, length);
+				return length;
+			});
+		}
+	}
+
+	/// @brief Compares integer and shortest floating point formatting of ToChars against std::to_chars and the previous approaches
+	inline void RunBenchmarks_ToChars()
+	{
+		std::cout << "RunBenchmarks_ToChars\n";
+
+		// Values spread over all magnitudes, so every digit count is represented
+		std::vector<uint64_t> values64;
+		std::vector<uint32_t> values32;
+		uint64_t state = 0x9E3779B97F4A7C15ull;
+		for (size_t index = 0; index < 100000; index++)
+		{
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			values64.push_back(state >> (index % 64));
+			values32.push_back(static_cast<uint32_t>(state >> (32 + index % 32)));
+		}
+		bench::CompareToChars("uint64_t, decimal", values64, 10);
+		bench::CompareToChars("uint32_t, decimal", values32, 10);
+		bench::CompareToChars("uint64_t, hexadecimal", values64, 16);
+		bench::CompareToChars("uint64_t, binary", values64, 2);
+
+		// Floating point values: random bit patterns and short decimals such as prices
+		std::vector<double> doubles;
+		std::vector<double> decimals;
+		std::vector<float> floats;
+		while (doubles.size() < 100000)
+		{
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			double value = std::bit_cast<double>(state);
+			float single = std::bit_cast<float>(static_cast<uint32_t>(state >> 32));
+			if (value == value && value - value == 0 && single == single && single - single == 0)
+			{
+				doubles.push_back(value);
+				floats.push_back(single);
+				decimals.push_back(static_cast<double>(state % 1000000) / 100.0);
+			}
+		}
+		for (auto [name, values] : { std::pair{ "double, random bits", &doubles }, std::pair{ "double, two decimals", &decimals } })
+		{
+			std::cout << name << "\n";
+			bench::MeasureToChars("jht::ToChars (shortest)", *values, [](char* buffer, double value) { return ToChars(buffer, value); });
+			bench::MeasureToChars("std::to_chars (shortest)", *values, [](char* buffer, double value)
+			{
+				return static_cast<size_t>(std::to_chars(buffer, buffer + tochars::MAXSHORTESTLENGTH, value).ptr - buffer);
+			});
+			bench::MeasureToChars("snprintf %.17g", *values, [](char* buffer, double value)
+			{
+				return static_cast<size_t>(snprintf(buffer, tochars::MAXSHORTESTLENGTH, "%.17g", value));
+			});
+		}
+		std::cout << "float, random bits\n";
+		bench::MeasureToChars("jht::ToChars (shortest)", floats, [](char* buffer, float value) { return ToChars(buffer, value); });
+		bench::MeasureToChars("std::to_chars (shortest)", floats, [](char* buffer, float value)
+		{
+			return static_cast<size_t>(std::to_chars(buffer, buffer + tochars::MAXSHORTESTLENGTH, value).ptr - buffer);
+		});
+	}
+}
\ No newline at end of file
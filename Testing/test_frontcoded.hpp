@@ -0,0 +1,96 @@
+#pragma once
+#include "jhtstring.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+#include <set>
+
+namespace jht
+{
+	inline void RunTests_FrontCoded()
+	{
+		std::cout << "RunTests_FrontCoded\n";
+
+		{ // Building
+			FrontCodedDictionary dictionary(4);
+			assert(dictionary.Build({ "", "a", "ab", "abc", "b" }));
+			assert(dictionary.Count() == 5);
+			assert(!dictionary.Build({ "a", "c", "b" }));
+			assert(dictionary.Count() == 0);
+			assert(!dictionary.Build({ "a", "a" }));
+			assert(dictionary.Build({}));
+			assert(dictionary.LowerBound("x") == 0);
+			assert(!FrontCodedDictionary::Iterator(dictionary));
+		}
+
+		{ // Rank, select and prefix ranges compared against a sorted set
+			std::set<std::string> reference;
+			uint32_t seed = 7;
+			for (int32_t i = 0; i < 3000; i++)
+			{
+				std::string key;
+				seed = seed * 1103515245 + 12345;
+				size_t length = (seed >> 16) % 8;
+				for (size_t c = 0; c < length; c++)
+				{
+					seed = seed * 1103515245 + 12345;
+					key.push_back("abc\xF0"[(seed >> 16) % 4]);
+				}
+				reference.insert(key);
+			}
+			std::vector<std::string> sorted(reference.begin(), reference.end());
+			std::vector<String> keys;
+			for (const std::string& key : sorted)
+			{
+				keys.push_back(String::MakeView(key));
+			}
+
+			for (size_t blockSize : { size_t(1), size_t(5), size_t(16) })
+			{
+				FrontCodedDictionary dictionary(blockSize);
+				assert(dictionary.Build(keys));
+				assert(dictionary.Count() == keys.size());
+
+				for (size_t i = 0; i < keys.size(); i++)
+				{
+					size_t index = 0;
+					assert(dictionary.Find(keys[i], index) && index == i);
+					assert(dictionary.Get(i) == keys[i]);
+				}
+
+				size_t visited = 0;
+				JHT_ITERATE(FrontCodedDictionary, dictionary, iter)
+				{
+					assert(*iter == keys[iter.Index()]);
+					visited++;
+				}
+				assert(visited == keys.size());
+
+				for (FrontCodedDictionary::Iterator iter(dictionary, keys.size() / 2); iter; ++iter)
+				{
+					assert(iter.Current() == keys[iter.Index()]);
+				}
+
+				const char* probes[] = { "", "a", "ab", "abca", "b", "ba", "c", "cccccccccc", "\xF0", "\xF0\xF0\xF0\xF0\xF0\xF0\xF0\xF0\xF0" };
+				for (const char* probe : probes)
+				{
+					std::string probeString(probe);
+					size_t expectedLower = std::lower_bound(sorted.begin(), sorted.end(), probeString) - sorted.begin();
+					assert(dictionary.LowerBound(probe) == expectedLower);
+					size_t index = 0;
+					assert(dictionary.Find(probe, index) == (reference.count(probeString) > 0));
+
+					size_t expectedEnd = expectedLower;
+					while (expectedEnd < sorted.size() && sorted[expectedEnd].compare(0, probeString.size(), probeString) == 0)
+					{
+						expectedEnd++;
+					}
+					size_t begin = 0;
+					size_t end = 0;
+					dictionary.PrefixRange(probe, begin, end);
+					assert(begin == expectedLower && end == expectedEnd);
+				}
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,99 @@
+#pragma once
+#include "jhtstring.hpp"
+#include <cassert>
+#include <iostream>
+
+namespace jht
+{
+	inline size_t NaiveEditDistance(const String& a, const String& b)
+	{
+		std::vector<size_t> row(b.Length() + 1);
+		for (size_t j = 0; j <= b.Length(); j++)
+		{
+			row[j] = j;
+		}
+		for (size_t i = 1; i <= a.Length(); i++)
+		{
+			size_t diagonal = row[0];
+			row[0] = i;
+			for (size_t j = 1; j <= b.Length(); j++)
+			{
+				size_t above = row[j];
+				size_t substitution = diagonal + (a[i - 1] == b[j - 1] ? 0 : 1);
+				row[j] = min(min(above + 1, row[j - 1] + 1), substitution);
+				diagonal = above;
+			}
+		}
+		return row[b.Length()];
+	}
+
+	inline void RunTests_Fuzzy()
+	{
+		std::cout << "RunTests_Fuzzy\n";
+
+		{ // Basic distances
+			assert(EditDistance("", "") == 0);
+			assert(EditDistance("", "abc") == 3);
+			assert(EditDistance("abc", "") == 3);
+			assert(EditDistance("kitten", "sitting") == 3);
+			assert(EditDistance("sitting", "kitten") == 3);
+			assert(EditDistance("flaw", "lawn") == 2);
+			assert(EditDistance("same", "same") == 0);
+		}
+
+		{ // Bounded distances
+			assert(EditDistance("kitten", "sitting", 3) == 3);
+			assert(EditDistance("kitten", "sitting", 2) == 3);
+			assert(EditDistance("a", "abcdefgh", 2) == 3);
+			assert(EditDistance("abcdefgh", "hgfedcba", 1) == 2);
+		}
+
+		{ // Multi block patterns compared against the naive implementation
+			uint32_t seed = 12345;
+			for (int32_t round = 0; round < 50; round++)
+			{
+				String a = String::MakeManaged(static_cast<size_t>(60 + round * 5));
+				String b = String::MakeManaged(static_cast<size_t>(50 + round * 6));
+				for (size_t i = 0; i < a.Length(); i++)
+				{
+					seed = seed * 1103515245 + 12345;
+					a[i] = static_cast<char>('a' + (seed >> 16) % 4);
+				}
+				for (size_t i = 0; i < b.Length(); i++)
+				{
+					seed = seed * 1103515245 + 12345;
+					b[i] = static_cast<char>('a' + (seed >> 16) % 4);
+				}
+				size_t expected = NaiveEditDistance(a, b);
+				assert(EditDistance(a, b) == expected);
+				assert(EditDistance(b, a) == expected);
+				assert(EditDistance(a, b, expected) == expected);
+				assert(EditDistance(a, b, expected - 1) == expected);
+			}
+		}
+
+		{ // Top k search
+			std::vector<String> candidates = { "apple", "apply", "ape", "maple", "banana", "applet", "apple" };
+			std::vector<FuzzyMatch> matches;
+
+			FuzzySearch(candidates, "appel", 3, 2, matches);
+			assert(matches.size() == 3);
+			assert(matches[0].Index == 0 && matches[0].Distance == 2);
+			assert(matches[1].Index == 1 && matches[1].Distance == 2);
+			assert(matches[2].Index == 2 && matches[2].Distance == 2);
+
+			FuzzySearch(candidates, "apple", 2, 5, matches);
+			assert(matches.size() == 2);
+			assert(matches[0].Index == 0 && matches[0].Distance == 0);
+			assert(matches[1].Index == 6 && matches[1].Distance == 0);
+
+			FuzzyMatcher matcher("banan");
+			matcher.Search(candidates, 10, 1, matches);
+			assert(matches.size() == 1);
+			assert(matches[0].Index == 4 && matches[0].Distance == 1);
+
+			matcher.Search(candidates, 0, 10, matches);
+			assert(matches.empty());
+		}
+	}
+}
\ No newline at end of file
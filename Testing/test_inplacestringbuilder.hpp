@@ -0,0 +1,79 @@
+#pragma once
+#include "jhtstring.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+
+namespace jht
+{
+	inline void RunTests_InplaceStringBuilder()
+	{
+		std::cout << "RunTests_InplaceStringBuilder\n";
+
+		{ // Basics
+			InplaceStringBuilder<64> builder;
+			assert(builder.Length() == 0 && builder.View() == "" && builder.Capacity() == 64);
+			builder << "key:" << 42 << ':' << -7 << ' ' << 1.5 << ' ' << true;
+			assert(builder.View() == "key:42:-7 1.5 true" && !builder.Overflowed());
+			builder.AppendUint(255, 16);
+			builder.AppendLine(String("!"));
+			String built = builder.Build();
+			assert(built == "key:42:-7 1.5 trueFF!\n" && built.IsManaged());
+			builder.Clear();
+			assert(builder.Length() == 0 && built == "key:42:-7 1.5 trueFF!\n");
+		}
+
+		{ // Truncate
+			InplaceStringBuilder<8, InplaceOverflow::Truncate> builder;
+			builder << "abcdef";
+			assert(!builder.Overflowed());
+			builder << 12345;
+			assert(builder.View() == "abcdef12" && builder.Overflowed());
+			builder << 'x' << "more";
+			assert(builder.View() == "abcdef12");
+			builder.Clear();
+			builder << 1234567;
+			assert(builder.View() == "1234567" && !builder.Overflowed());
+		}
+
+		{ // Fail
+			InplaceStringBuilder<8, InplaceOverflow::Fail> builder;
+			builder << "abcdef" << 123;
+			assert(builder.View() == "abcdef" && builder.Overflowed());
+			builder << 'x' << 'y';
+			assert(builder.View() == "abcdefxy");
+			builder << 'z';
+			assert(builder.View() == "abcdefxy");
+		}
+
+		{ // Spill
+			InplaceStringBuilder<8, InplaceOverflow::Spill> builder;
+			std::string expected;
+			for (int index = 0; index < 100; index++)
+			{
+				builder << index << ',';
+				expected += std::to_string(index) + ",";
+			}
+			assert(builder.Overflowed() && builder.Capacity() >= expected.length());
+			assert(builder.View() == String::MakeView(expected) && builder.Build() == String::MakeView(expected));
+			builder.Clear();
+			builder << "reused";
+			assert(builder.View() == "reused");
+
+			// Copies of a spilled builder do not share its heap buffer
+			builder << " and spilled again";
+			InplaceStringBuilder<8, InplaceOverflow::Spill> copy(builder);
+			copy << " by the copy";
+			builder << "!";
+			assert(builder.View() == "reused and spilled again!" && copy.View() == "reused and spilled again by the copy");
+			InplaceStringBuilder<8, InplaceOverflow::Spill> assigned;
+			assigned << "short";
+			builder = assigned;
+			assigned << "+";
+			assert(builder.View() == "short" && assigned.View() == "short+");
+			assigned = copy;
+			assigned << "?";
+			assert(copy.View() == "reused and spilled again by the copy" && assigned.View() == "reused and spilled again by the copy?");
+		}
+	}
+}
\ No newline at end of file
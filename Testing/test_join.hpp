@@ -0,0 +1,69 @@
+#pragma once
+#include "jhtstring.hpp"
+#include <cassert>
+#include <iostream>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace jht
+{
+	inline void RunTests_Join()
+	{
+		std::cout << "RunTests_Join\n";
+
+		{ // Basics
+			std::vector<String> empty;
+			assert(Join(empty, ",").Length() == 0);
+
+			std::vector<String> values = { "alpha", "", "gamma" };
+			String joined = Join(values, ", ");
+			assert(joined == "alpha, , gamma" && joined.IsManaged());
+			assert(Join(values, "") == "alphagamma");
+			assert(Join(std::vector<String>{ "single" }, "--") == "single");
+
+			std::list<String> list = { "a", "b", "c" };
+			assert(Join(list, "/") == "a/b/c");
+
+			String csv = "one;two;;three";
+			std::vector<String> fields;
+			csv.Split(';', fields, false);
+			assert(Join(fields, ";") == csv);
+		}
+
+		{ // Columns
+			struct Row
+			{
+				String Name;
+				int32_t Age;
+			};
+			std::vector<Row> rows = { { "ann", 31 }, { "bob", 42 }, { "cyd", 27 } };
+			assert(JoinBy(rows, "|", [](const Row& row) -> const String& { return row.Name; }) == "ann|bob|cyd");
+			assert(JoinBy(rows, ",", [](const Row& row) { return ToString(row.Age); }) == "31,42,27");
+		}
+
+		{ // Parallel copy
+			std::vector<String> pieces;
+			std::string expected;
+			for (size_t index = 0; index < 1200000; index++)
+			{
+				pieces.push_back(index % 3 ? "abcdefgh" : "0123");
+				expected += index ? "," : "";
+				expected += index % 3 ? "abcdefgh" : "0123";
+			}
+			assert(expected.length() >= join::PARALLELTHRESHOLD);
+			assert(Join(pieces, ",", 4) == String::MakeView(expected));
+			assert(Join(pieces, ",", 1) == String::MakeView(expected));
+			assert(Join(pieces, ",", 7) == String::MakeView(expected));
+
+			// Projections returning copies of managed Strings run on the calling thread, references are copied in parallel
+			std::vector<String> managed;
+			for (const String& piece : pieces)
+			{
+				managed.push_back(piece.MakeCopy());
+			}
+			assert(JoinBy(managed, ",", [](const String& piece) { return piece; }, 4) == String::MakeView(expected));
+			assert(JoinBy(managed, ",", [](const String& piece) -> const String& { return piece; }, 4) == String::MakeView(expected));
+		}
+	}
+}
\ No newline at end of file
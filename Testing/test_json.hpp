@@ -0,0 +1,61 @@
+#pragma once
+#include "jhtstring.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+
+namespace jht
+{
+	inline void RunTests_Json()
+	{
+		std::cout << "RunTests_Json\n";
+
+		{ // Escaping
+			StringBuilder builder;
+			builder.AppendJsonEscaped("plain");
+			assert(builder.Build() == "plain");
+
+			StringBuilder escaped;
+			escaped.AppendJsonEscaped(String("say \"hi\"\\\n\t\x01\x1F end \xC3\xA9", 20));
+			assert(escaped.Build() == "say \\\"hi\\\"\\\\\\n\\t\\u0001\\u001F end \xC3\xA9");
+
+			std::string longText(200, 'a');
+			longText[17] = '"';
+			longText[150] = '\n';
+			StringBuilder sections;
+			sections.AppendJsonEscaped(String::MakeManaged(longText.c_str()));
+			String result = sections.Build();
+			assert(result.Length() == 202 && result.SubString(17, 2) == "\\\"" && result.SubString(151, 2) == "\\n");
+
+			// Clean runs are staged instead of becoming one section each
+			StringBuilder repeated;
+			String field("a field value that is longer than the threshold.");
+			for (int32_t i = 0; i < 1000; i++)
+			{
+				repeated.AppendJsonEscaped(field);
+			}
+			assert(repeated.Length() == 1000 * field.Length() && repeated.Stats().Sections == 0);
+			assert(repeated.Stats().Flushes <= repeated.Length() / StringBuilder::BUFFERSIZE);
+		}
+
+		{ // Unescaping
+			String clean("nothing to resolve in this rather long value");
+			String unescaped = JsonUnescape(clean);
+			assert(unescaped == clean && !unescaped.IsManaged() && unescaped.ConstData() == clean.ConstData());
+
+			unescaped = JsonUnescape("say \\\"hi\\\"\\\\\\n\\t\\/\\u0041\\u00e9\\u20AC\\ud83d\\ude00!");
+			assert(unescaped.IsManaged() && unescaped == "say \"hi\"\\\n\t/A\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80!");
+
+			String out;
+			assert(TryJsonUnescape("a\\nb", out) && out == "a\nb");
+			assert(!TryJsonUnescape("bad \\x and \\u12", out) && out == "bad \\x and \\u12");
+			assert(JsonUnescape("bad \\x and \\u12") == "bad \\x and \\u12");
+			assert(JsonUnescape("trailing \\") == "trailing \\");
+
+			StringBuilder roundTrip;
+			String original("line\none \"quoted\" \\ \x02 tail");
+			roundTrip.AppendJsonEscaped(original);
+			assert(JsonUnescape(roundTrip.Build()) == original);
+		}
+	}
+}
\ No newline at end of file
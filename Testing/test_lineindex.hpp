@@ -0,0 +1,72 @@
+#pragma once
+#include "jhtstring.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+
+namespace jht
+{
+	inline void RunTests_LineIndex()
+	{
+		std::cout << "RunTests_LineIndex\n";
+
+		{ // Basics
+			LineIndex empty;
+			assert(empty.LineCount() == 1 && empty.Line(0) == "");
+
+			LineIndex index("first\r\nsecond\n\nlast");
+			assert(index.LineCount() == 4);
+			assert(index.Line(0) == "first" && index.Line(1) == "second" && index.Line(2) == "" && index.Line(3) == "last");
+			size_t line = 0;
+			size_t column = 0;
+			index.Position(0, line, column);
+			assert(line == 0 && column == 0);
+			index.Position(6, line, column);
+			assert(line == 0 && column == 6);
+			index.Position(7, line, column);
+			assert(line == 1 && column == 0);
+			index.Position(19, line, column);
+			assert(line == 3 && column == 4);
+
+			LineIndex trailing("a\n");
+			assert(trailing.LineCount() == 2 && trailing.Line(1) == "");
+		}
+
+		{ // Compared against a naive scan, built at once and incrementally
+			std::string text;
+			uint32_t seed = 5;
+			for (int32_t i = 0; i < 5000; i++)
+			{
+				seed = seed * 1103515245 + 12345;
+				text.push_back((seed >> 16) % 7 == 0 ? '\n' : static_cast<char>('a' + (seed >> 16) % 26));
+			}
+			LineIndex built(String::MakeView(text));
+			LineIndex extended;
+			for (size_t length = 0; length <= text.size(); length += 1 + length % 37)
+			{
+				extended.Extend(String::MakeView(text.data(), length));
+			}
+			extended.Extend(String::MakeView(text));
+			assert(extended.LineCount() == built.LineCount());
+
+			size_t line = 0;
+			size_t lineStart = 0;
+			for (size_t offset = 0; offset <= text.size(); offset++)
+			{
+				size_t foundLine = 0;
+				size_t foundColumn = 0;
+				built.Position(offset, foundLine, foundColumn);
+				assert(foundLine == line && foundColumn == offset - lineStart);
+				extended.Position(offset, foundLine, foundColumn);
+				assert(foundLine == line && foundColumn == offset - lineStart);
+				if (offset < text.size() && text[offset] == '\n')
+				{
+					assert(built.Line(line) == String::MakeView(text.data() + lineStart, offset - lineStart));
+					line++;
+					lineStart = offset + 1;
+				}
+			}
+			assert(built.LineCount() == line + 1);
+		}
+	}
+}
\ No newline at end of file
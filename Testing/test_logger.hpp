@@ -0,0 +1,106 @@
+#pragma once
+#include "jhtstring.hpp"
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace loggertest
+{
+	/// @brief Logs a record of its own while being appended to another record
+	struct Noisy
+	{
+		jht::Logger* Target;
+	};
+
+	inline void AppendTo(jht::StringBuilder& builder, const Noisy& noisy)
+	{
+		noisy.Target->Log(jht::LogLevel::Info, "nested ", 1);
+		builder << "noisy";
+	}
+}
+
+namespace jht
+{
+	inline void RunTests_Logger()
+	{
+		std::cout << "RunTests_Logger\n";
+
+#ifndef _WIN32
+		FILE* file = tmpfile();
+		assert(file);
+		const size_t THREADS = 4;
+		const size_t RECORDS = 5000;
+		{
+			Logger logger(fileno(file), LogLevel::Debug, std::chrono::microseconds(100));
+			assert(logger.IsEnabled(LogLevel::Warning) && !logger.IsEnabled(LogLevel::Trace));
+			logger.Log(LogLevel::Trace, "dropped");
+			logger.Log(LogLevel::Info, "started ", 2, " workers, ratio ", 0.5);
+			assert(logger.Flush() && logger.WrittenCount() == 1);
+
+			std::vector<std::thread> threads;
+			for (size_t thread = 0; thread < THREADS; thread++)
+			{
+				threads.emplace_back([&logger, thread]()
+				{
+					static const String KEYTHREAD("thread");
+					static const String KEYINDEX("index");
+					for (size_t index = 0; index < RECORDS; index++)
+					{
+						logger.LogFields(LogLevel::Debug, "tick", KEYTHREAD, thread, KEYINDEX, index);
+					}
+				});
+			}
+			for (std::thread& thread : threads)
+			{
+				thread.join();
+			}
+			logger.SetMinLevel(LogLevel::Error);
+			logger.Log(LogLevel::Warning, "dropped");
+			logger.Log(LogLevel::Error, String("done"));
+		}
+
+		rewind(file);
+		std::vector<std::string> lines;
+		char line[256];
+		while (fgets(line, sizeof(line), file))
+		{
+			lines.push_back(line);
+		}
+		fclose(file);
+		assert(lines.size() == THREADS * RECORDS + 2);
+		assert(lines.front() == "INFO  started 2 workers, ratio 0.5\n" && lines.back() == "ERROR done\n");
+
+		// Records of each thread arrive complete and in order
+		std::vector<size_t> next(THREADS, 0);
+		for (size_t index = 1; index + 1 < lines.size(); index++)
+		{
+			size_t thread = 0;
+			size_t record = 0;
+			assert(sscanf(lines[index].c_str(), "DEBUG tick thread=%zu index=%zu\n", &thread, &record) == 2);
+			assert(thread < THREADS && record == next[thread]);
+			next[thread]++;
+		}
+
+		// A record logged while another one is formatted on the same thread leaves the outer record intact
+		FILE* nestedFile = tmpfile();
+		assert(nestedFile);
+		{
+			Logger logger(fileno(nestedFile));
+			logger.Log(LogLevel::Info, "outer ", loggertest::Noisy{ &logger }, " end");
+			logger.Log(LogLevel::Info, "after");
+			assert(logger.Flush() && logger.WrittenCount() == 3 && logger.DroppedCount() == 0);
+		}
+		rewind(nestedFile);
+		std::string nested;
+		while (fgets(line, sizeof(line), nestedFile))
+		{
+			nested += line;
+		}
+		fclose(nestedFile);
+		assert(nested == "INFO  nested 1\nINFO  outer noisy end\nINFO  after\n");
+#endif
+	}
+}
\ No newline at end of file
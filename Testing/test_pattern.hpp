@@ -0,0 +1,96 @@
+#pragma once
+#include "jhtstring.hpp"
+#include <cassert>
+#include <iostream>
+
+namespace jht
+{
+	inline void RunTests_Pattern()
+	{
+		std::cout << "RunTests_Pattern\n";
+
+		{ // Regex literals, classes and quantifiers
+			Pattern pattern;
+			assert(Pattern::TryCompileRegex("ab+c?", pattern));
+			assert(pattern.IsValid());
+			assert(pattern.Matches("abbb"));
+			assert(pattern.Matches("xxabcxx"));
+			assert(!pattern.Matches("ac"));
+			assert(!pattern.Matches(""));
+
+			assert(Pattern::TryCompileRegex("[a-c]x*[^0-9]", pattern));
+			assert(pattern.Matches("bxxxz"));
+			assert(pattern.Matches("cz"));
+			assert(!pattern.Matches("c1 a2"));
+
+			assert(Pattern::TryCompileRegex("\\d+\\.\\d", pattern));
+			assert(pattern.Matches("version 12.5"));
+			assert(!pattern.Matches("version 12x5"));
+		}
+
+		{ // Regex alternation, groups and anchors
+			Pattern pattern;
+			assert(Pattern::TryCompileRegex("^(GET|POST) /api", pattern));
+			assert(pattern.Matches("GET /api/users"));
+			assert(pattern.Matches("POST /api"));
+			assert(!pattern.Matches("PUT /api"));
+			assert(!pattern.Matches(" GET /api"));
+
+			assert(Pattern::TryCompileRegex("\\.(png|jpe?g)$", pattern));
+			assert(pattern.Matches("image.jpeg"));
+			assert(pattern.Matches("image.jpg"));
+			assert(!pattern.Matches("image.jpg.bak"));
+
+			assert(Pattern::TryCompileRegex("^$", pattern));
+			assert(pattern.Matches(""));
+			assert(!pattern.Matches("a"));
+
+			assert(Pattern::TryCompileRegex("(a|)*b", pattern));
+			assert(pattern.Matches("aaab"));
+			assert(pattern.Matches("b"));
+		}
+
+		{ // Globs
+			Pattern pattern;
+			assert(Pattern::TryCompileGlob("*.txt", pattern));
+			assert(pattern.Matches("notes.txt"));
+			assert(pattern.Matches(".txt"));
+			assert(!pattern.Matches("notes.txt.old"));
+
+			assert(Pattern::TryCompileGlob("/static/{css,js}/?*.[!t]*", pattern));
+			assert(pattern.Matches("/static/css/site.min.css"));
+			assert(pattern.Matches("/static/js/a.js"));
+			assert(!pattern.Matches("/static/js/.js"));
+			assert(!pattern.Matches("/static/img/a.png"));
+			assert(!pattern.Matches("/static/js/a.txt"));
+
+			assert(Pattern::TryCompileGlob("a\\*b", pattern));
+			assert(pattern.Matches("a*b"));
+			assert(!pattern.Matches("axb"));
+		}
+
+		{ // Syntax errors
+			Pattern pattern;
+			assert(!Pattern::TryCompileRegex("(ab", pattern));
+			assert(!Pattern::TryCompileRegex("ab)", pattern));
+			assert(!Pattern::TryCompileRegex("*a", pattern));
+			assert(!Pattern::TryCompileRegex("a+?", pattern));
+			assert(!Pattern::TryCompileRegex("a*+", pattern));
+			assert(!Pattern::TryCompileRegex("(ab)??", pattern));
+			assert(!Pattern::TryCompileRegex("[a-", pattern));
+			assert(!Pattern::TryCompileRegex("[z-a]", pattern));
+			assert(!Pattern::TryCompileGlob("{a,b", pattern));
+			assert(!pattern.IsValid());
+			assert(!pattern.Matches("a"));
+		}
+
+		{ // Long inputs exercising the prefilter and the state cache
+			Pattern pattern;
+			assert(Pattern::TryCompileRegex("x[0-9][0-9]y", pattern));
+			String haystack = String::MakeManaged('a', 10000);
+			assert(!pattern.Matches(haystack));
+			haystack.Fill("x42y", 4, 9000);
+			assert(pattern.Matches(haystack));
+		}
+	}
+}
\ No newline at end of file
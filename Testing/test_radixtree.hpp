@@ -0,0 +1,109 @@
+#pragma once
+#include "jhtstring.hpp"
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <string>
+
+namespace jht
+{
+	inline void RunTests_RadixTree()
+	{
+		std::cout << "RunTests_RadixTree\n";
+
+		{ // Exact lookup
+			RadixTree<int32_t> tree;
+			assert(tree.Insert("romane", 1));
+			assert(tree.Insert("romanus", 2));
+			assert(tree.Insert("romulus", 3));
+			assert(tree.Insert("rubens", 4));
+			assert(tree.Insert("rom", 5));
+			assert(tree.Insert("", 6));
+			assert(!tree.Insert("rubens", 7));
+			assert(tree.Count() == 6);
+
+			assert(*tree.Find("romane") == 1);
+			assert(*tree.Find("romanus") == 2);
+			assert(*tree.Find("romulus") == 3);
+			assert(*tree.Find("rubens") == 7);
+			assert(*tree.Find("rom") == 5);
+			assert(*tree.Find("") == 6);
+			assert(!tree.Find("roman"));
+			assert(!tree.Find("ro"));
+			assert(!tree.Find("rubensx"));
+			assert(!tree.Find("x"));
+
+			String key = String::MakeManaged("romulus and remus");
+			assert(*tree.Find(key.SubString(0, 7)) == 3);
+		}
+
+		{ // Longest prefix
+			RadixTree<int32_t> tree;
+			tree.Insert("/", 0);
+			tree.Insert("/api", 1);
+			tree.Insert("/api/v1", 2);
+			tree.Insert("/api/v1/users", 3);
+			tree.Insert("/static", 4);
+
+			assert(tree.LongestPrefix("/api/v1/users/42")->Value == 3);
+			assert(tree.LongestPrefix("/api/v1/user")->Value == 2);
+			assert(tree.LongestPrefix("/api/v2")->Value == 1);
+			assert(tree.LongestPrefix("/apis")->Value == 1);
+			assert(tree.LongestPrefix("/staticfile")->Value == 4);
+			assert(tree.LongestPrefix("/other")->Key == "/");
+			assert(!tree.LongestPrefix("api"));
+		}
+
+		{ // Prefix iteration, node growth and ordering
+			RadixTree<int32_t> tree;
+			std::map<std::string, int32_t> reference;
+			uint32_t seed = 42;
+			for (int32_t i = 0; i < 5000; i++)
+			{
+				std::string key;
+				seed = seed * 1103515245 + 12345;
+				size_t length = (seed >> 16) % 6;
+				for (size_t c = 0; c < length; c++)
+				{
+					seed = seed * 1103515245 + 12345;
+					key.push_back(static_cast<char>(((seed >> 16) % 200) + 1));
+				}
+				bool inserted = tree.Insert(String::MakeView(key), i);
+				assert(inserted == (reference.find(key) == reference.end()));
+				reference[key] = i;
+			}
+			assert(tree.Count() == reference.size());
+			for (const std::pair<const std::string, int32_t>& pair : reference)
+			{
+				assert(*tree.Find(String::MakeView(pair.first)) == pair.second);
+			}
+
+			std::vector<String> visited;
+			tree.ForEachWithPrefix("", [&](const RadixTree<int32_t>::Entry& entry) { visited.push_back(entry.Key); });
+			assert(visited.size() == reference.size());
+			for (size_t i = 1; i < visited.size(); i++)
+			{
+				assert(memcmp(visited[i - 1].ConstData(), visited[i].ConstData(), min(visited[i - 1].Length(), visited[i].Length())) <= 0);
+			}
+
+			RadixTree<int32_t> paths;
+			paths.Insert("config.db.host", 1);
+			paths.Insert("config.db.port", 2);
+			paths.Insert("config.dbx", 3);
+			paths.Insert("config.cache", 4);
+			std::vector<int32_t> values;
+			paths.ForEachWithPrefix("config.db.", [&](const RadixTree<int32_t>::Entry& entry) { values.push_back(entry.Value); });
+			assert(values.size() == 2 && values[0] == 1 && values[1] == 2);
+			values.clear();
+			paths.ForEachWithPrefix("config.d", [&](const RadixTree<int32_t>::Entry& entry) { values.push_back(entry.Value); });
+			assert(values.size() == 3);
+			values.clear();
+			paths.ForEachWithPrefix("config.e", [&](const RadixTree<int32_t>::Entry& entry) { values.push_back(entry.Value); });
+			assert(values.empty());
+
+			tree.Clear();
+			assert(tree.Count() == 0);
+			assert(!tree.Find(""));
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+#include "jhtstring.hpp"
+#include <cassert>
+#include <iostream>
+#include <map>
+#include <string>
+
+namespace jht
+{
+	inline void RunTests_Serialization()
+	{
+		std::cout << "RunTests_Serialization\n";
+
+		std::vector<String> values = { "", "a", String::MakeManaged("managed"), "a longer string that is appended as its own section", "" };
+		std::string large(300, 'L');
+		values.push_back(String::MakeView(large));
+
+		for (bool withIndex : { false, true })
+		{ // Round trip
+			StringBuilder builder;
+			SerializeStrings(values, builder, withIndex);
+			String data = builder.Build();
+
+			SerializedStrings serialized;
+			assert(SerializedStrings::TryOpen(data, serialized));
+			assert(serialized.Count() == values.size() && serialized.IsIndexed() == withIndex && !serialized.HasPairs());
+			for (size_t index = 0; index < values.size(); index++)
+			{
+				String value = serialized.Get(index);
+				assert(value == values[index] && !value.IsManaged());
+				assert(value.Length() == 0 || (value.ConstData() >= data.ConstData() && value.ConstData() < data.ConstData() + data.Length()));
+			}
+			JHT_ITERATE(SerializedStrings, serialized, iter)
+			{
+				assert(*iter == values[iter.Index()]);
+			}
+
+			std::vector<String> read;
+			assert(TryDeserializeStrings(data, read));
+			assert(read == values);
+
+			// Truncated or extended buffers are rejected
+			for (size_t length = 0; length < data.Length(); length++)
+			{
+				assert(!SerializedStrings::TryOpen(data.SubString(0, length), serialized));
+			}
+			StringBuilder extended;
+			extended << data << 'x';
+			assert(!SerializedStrings::TryOpen(extended.Build(), serialized));
+		}
+
+		{ // Empty collection
+			StringBuilder builder;
+			SerializeStrings({}, builder);
+			std::vector<String> read;
+			assert(TryDeserializeStrings(builder.Build(), read) && read.empty());
+			assert(!TryDeserializeStrings("", read));
+		}
+
+		{ // Maps
+			std::map<std::string, std::string> map = { { "one", "1" }, { "two", "2" }, { "empty", "" } };
+			StringBuilder builder;
+			SerializeStringMap(map, builder, true);
+			String data = builder.Build();
+
+			SerializedStrings serialized;
+			assert(SerializedStrings::TryOpen(data, serialized) && serialized.HasPairs());
+			std::vector<std::pair<String, String>> pairs;
+			serialized.ReadPairs(pairs);
+			assert(pairs.size() == 3);
+			for (const std::pair<String, String>& pair : pairs)
+			{
+				const std::string& value = map.at(std::string(pair.first.ConstData(), pair.first.Length()));
+				assert(pair.second == String::MakeView(value));
+			}
+
+			std::vector<std::pair<String, String>> stringPairs = { { "key", "value" } };
+			StringBuilder pairBuilder;
+			SerializeStringMap(stringPairs, pairBuilder);
+			pairs.clear();
+			assert(SerializedStrings::TryOpen(pairBuilder.Build(), serialized));
+			serialized.ReadPairs(pairs);
+			assert(pairs.size() == 1 && pairs[0].first == "key" && pairs[0].second == "value");
+		}
+	}
+}
\ No newline at end of file
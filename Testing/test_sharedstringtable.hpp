@@ -0,0 +1,69 @@
+#pragma once
+#include "jhtstring.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+
+namespace jht
+{
+	inline void RunTests_SharedStringTable()
+	{
+		std::cout << "RunTests_SharedStringTable\n";
+
+		const String name = "/jhtstring_test_sharedstringtable";
+		SharedStringTable::Remove(name);
+
+		{ // Building and publishing
+			std::vector<std::string> storage;
+			for (int32_t i = 0; i < 1000; i++)
+			{
+				storage.push_back("key_" + std::to_string(i * 7919 % 1000));
+			}
+			SharedStringTableBuilder builder;
+			assert(builder.Add("") == 0);
+			assert(builder.Add("alpha") == 1);
+			assert(builder.Add("alpha") == 1);
+			for (const std::string& key : storage)
+			{
+				builder.Add(String::MakeView(key));
+			}
+			assert(builder.Count() == 1002);
+
+			SharedStringTable table;
+			assert(!table.IsAttached() && table.Count() == 0);
+			assert(!SharedStringTable::TryAttach(name, table));
+			assert(builder.TryPublish(name, table));
+			assert(table.IsAttached() && table.Count() == 1002);
+
+			SharedStringTable other;
+			assert(!builder.TryPublish(name, other));
+
+			// A second attachment maps the same data at another address
+			assert(SharedStringTable::TryAttach(name, other));
+			assert(other.Count() == table.Count());
+			assert(other.Get(1).ConstData() != table.Get(1).ConstData());
+
+			for (size_t id = 0; id < table.Count(); id++)
+			{
+				String value = other.Get(id);
+				assert(!value.IsManaged());
+				assert(value.ConstData()[value.Length()] == 0);
+				size_t found = SIZE_MAX;
+				assert(table.Find(value, found) && found == id);
+			}
+			size_t found = SIZE_MAX;
+			assert(other.Find("key_999", found) && other.Get(found) == "key_999");
+			assert(!other.Find("key_1000", found));
+			assert(other.Find("", found) && found == 0);
+
+			SharedStringTable moved(std::move(other));
+			assert(!other.IsAttached() && moved.Count() == 1002);
+			moved.Detach();
+			assert(!moved.IsAttached());
+		}
+
+		assert(SharedStringTable::Remove(name));
+		SharedStringTable table;
+		assert(!SharedStringTable::TryAttach(name, table));
+	}
+}
\ No newline at end of file
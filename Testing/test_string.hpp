@@ -72,6 +72,22 @@ namespace jht
 			assert(strcmp(str7.ConstData(), strview.data()) == 0);
 		}
 
+		{ // Compile time literals
+			String str0 = "a const char* cstr"_js;
+			assert(!str0.IsManaged());
+			assert(str0.Length() == strlen("a const char* cstr"));
+			assert(str0 == String("a const char* cstr"));
+			assert(str0 != "a const char*"_js);
+
+			String str1 = "embedded\0null"_js;
+			assert(str1.Length() == 13);
+
+			constexpr uint64_t hash = String::Hash("abc", 3);
+			assert("abc"_js.Hash() == hash);
+			assert(String::MakeManaged("abc").Hash() == hash);
+			assert("abd"_js.Hash() != hash);
+		}
+
 		{ // Copying
 			String str0;
 			{
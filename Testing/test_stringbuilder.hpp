@@ -0,0 +1,412 @@
+#pragma once
+#include "jhtstring.hpp"
+#include <cassert>
+#include <cstdio>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace appendtotest
+{
+	struct Point
+	{
+		int32_t X;
+		int32_t Y;
+	};
+
+	struct Opaque
+	{
+	};
+
+	enum class Color
+	{
+		Red = 1,
+		Green = 2
+	};
+
+	inline void AppendTo(jht::StringBuilder& builder, const Point& point)
+	{
+		builder << "Point(" << point.X << ", " << point.Y << ')';
+	}
+
+	/// @brief Counts its copies, to check that appending does not copy values
+	struct Counted
+	{
+		static inline size_t Copies = 0;
+
+		Counted() = default;
+		Counted(const Counted&) { Copies++; }
+	};
+
+	inline void AppendTo(jht::StringBuilder& builder, const Counted&)
+	{
+		builder << "counted";
+	}
+}
+
+namespace jht
+{
+	inline void RunTests_StringBuilder()
+	{
+		std::cout << "RunTests_StringBuilder\n";
+
+		std::string longText(100, 'L');
+
+		{ // Sections
+			StringBuilder builder;
+			assert(builder.Build().Length() == 0 && builder.Capacity() == 0);
+			builder << "abc" << 'd' << String::MakeView(longText) << "e";
+			assert(builder.Length() == 105);
+			String built = builder.Build();
+			assert(built.IsManaged() && built == String::MakeManaged(("abcd" + longText + "e").c_str()));
+
+			StringBuilder single;
+			String managed = String::MakeManaged(longText.c_str());
+			single.Append(managed);
+			assert(single.Build().ConstData() == managed.ConstData());
+		}
+
+		{ // Numbers formatted in place
+			StringBuilder builder;
+			builder << int8_t(-5) << ' ' << uint16_t(65535) << ' ' << INT64_MIN << ' ' << UINT64_MAX << ' ' << 2.5 << ' ' << -0.25f << ' ' << true;
+			assert(builder.Build() == "-5 65535 -9223372036854775808 18446744073709551615 2.5 -0.25 true");
+
+			StringBuilder formats;
+			formats.AppendInt(-10, 2);
+			formats.Append(' ');
+			formats.AppendUint(255, 8);
+			formats.Append(' ');
+			formats.AppendHex(0xBEEF);
+			formats.Append(' ');
+			formats.AppendHex(0xBEEF, 8);
+			formats.Append(' ');
+			formats.AppendHex(0, 40);
+			formats.Append(' ');
+			formats.AppendDouble(3.14159, 2);
+			assert(formats.Build() == "-1010 377 BEEF 0000BEEF 0000000000000000 3.14");
+
+			// Many numbers cross the staging buffer boundary
+			StringBuilder many;
+			std::string expected;
+			for (int32_t i = 0; i < 1000; i++)
+			{
+				many << i * 7919 << ',';
+				expected += std::to_string(i * 7919) + ",";
+			}
+			assert(many.Build() == String::MakeView(expected));
+		}
+
+		{ // Integers reserve only the room their radix needs, so the staging buffer fills up before it is flushed
+			StringBuilder builder;
+			for (int32_t i = 0; i < 10000; i++)
+			{
+				builder.Append(12345);
+				builder.Append(',');
+			}
+			assert(builder.Length() == 60000 && builder.Stats().Flushes <= 60000 / (StringBuilder::BUFFERSIZE - tochars::MAXDECIMALLENGTH<int32_t>) + 1);
+		}
+
+		{ // Contiguous buffer
+			StringBuilder builder;
+			builder << "before" << String::MakeView(longText);
+			builder.Reserve(64);
+			assert(builder.Capacity() >= 106);
+			std::string expected = "before" + longText;
+			for (int32_t i = 0; i < 1000; i++)
+			{
+				builder << "x" << 'y';
+				expected += "xy";
+			}
+			assert(builder.Length() == expected.size());
+
+			String built = builder.Build();
+			assert(built.IsManaged() && built == String::MakeView(expected) && built.ConstData()[built.Length()] == 0);
+			assert(builder.Build() == built);
+			assert(StringHandle(built).Length() == expected.size());
+
+			// Appending after Build leaves the built String untouched
+			builder << "more";
+			assert(built == String::MakeView(expected));
+			assert(builder.Build() == String::MakeView(expected + "more"));
+
+			StringBuilder reserved;
+			reserved.Reserve(1000);
+			assert(reserved.Capacity() == 1000 && reserved.Build().Length() == 0);
+			reserved.Append(String::MakeView(longText));
+			String copied = reserved.Build();
+			assert(copied.Length() == 100 && copied == String::MakeView(longText) && reserved.Capacity() == 1000);
+			reserved.AppendUint(42);
+			assert(reserved.Build() == String::MakeView(longText + "42"));
+
+			// A buffer that is mostly full is handed over without copying
+			StringBuilder exact;
+			exact.Reserve(100);
+			exact.Append(String::MakeView(longText));
+			String handedOver = exact.Build();
+			assert(handedOver.Length() == 100 && exact.Capacity() == 0);
+			assert(exact.Build().ConstData() == handedOver.ConstData());
+			exact.AppendUint(42);
+			assert(exact.Build() == String::MakeView(longText + "42") && handedOver == String::MakeView(longText));
+		}
+
+		{ // Clearing and pooling
+			StringBuilder builder;
+			builder << "first" << String::MakeView(longText);
+			builder.Clear();
+			assert(builder.Length() == 0 && builder.Build().Length() == 0);
+			builder << "second";
+			assert(builder.Build() == "second");
+
+			StringBuilder* pooled = nullptr;
+			{
+				StringBuilderLease lease;
+				pooled = &lease.Get();
+				lease->Append("leased");
+				assert(lease->Build() == "leased");
+			}
+			assert(StringBuilderPool::PooledCount() >= 1);
+			{
+				StringBuilderLease lease;
+				assert(&*lease == pooled && lease->Length() == 0);
+				StringBuilderLease nested;
+				assert(&*nested != pooled);
+			}
+			{
+				StringBuilderLease lease;
+				std::ostringstream sink;
+				lease->SetSink(sink, 16);
+				lease->AcquireWrite(StringBuilder::BUFFERSIZE * 4);
+				lease->CommitWrite(0);
+				lease->Append("written to the sink");
+				assert(sink.str() == "written to the sink" && lease->BufferSize() > StringBuilder::BUFFERSIZE);
+			}
+			{
+				// Sink, statistics and the grown staging buffer do not carry over to the next lease
+				StringBuilderLease lease;
+				lease->Append(String::MakeView(longText));
+				assert(lease->Length() == 100 && lease->BufferSize() == StringBuilder::BUFFERSIZE && lease->Stats().Appends == 1);
+			}
+
+			std::istringstream stream("line one\r\n\nlast line without newline");
+			assert(GetLine(stream) == "line one\r");
+			assert(GetLine(stream) == "");
+			assert(GetLine(stream) == "last line without newline");
+			assert(GetLine(stream) == "");
+		}
+
+		{ // Unicode
+			StringBuilder builder;
+			builder.AppendCodepoint(U'A');
+			builder.AppendCodepoint(U'\u00E9');
+			builder.AppendCodepoint(U'\u20AC');
+			builder.AppendCodepoint(U'\U0001F600');
+			builder.AppendCodepoint(0xD800);
+			builder.AppendCodepoint(0x110000);
+			assert(builder.Build() == "A\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80\xEF\xBF\xBD\xEF\xBF\xBD");
+
+			std::u16string utf16 = u"plain ascii text that is longer than one block of the staging buffer, so it is split up"
+				u" into several writes \u00E4\u00F6\u00FC \u20AC \U0001F600 end";
+			UTF8EncoderChar encoder;
+			std::u32string utf32 = UTF16DecoderChar16t().DecodeMulti(utf16);
+			std::string expected = encoder.EncodeMulti(utf32);
+
+			StringBuilder sections;
+			sections.AppendUtf16(utf16);
+			assert(sections.Build() == String::MakeView(expected));
+			StringBuilder contiguous;
+			contiguous.Reserve(16);
+			contiguous.AppendUtf32(utf32);
+			assert(contiguous.Build() == String::MakeView(expected));
+
+			std::u16string broken = { u'a', char16_t(0xDC00), u'b', char16_t(0xD83D) };
+			StringBuilder replaced;
+			replaced.AppendUtf16(broken);
+			assert(replaced.Build() == "a\xEF\xBF\xBD" "b\xEF\xBF\xBD");
+
+			// Short inputs only reserve what they need, and blocks follow a configured staging buffer size
+			StringBuilder interleaved;
+			std::string interleavedExpected;
+			for (int32_t i = 0; i < 1000; i++)
+			{
+				interleaved.Append("x");
+				interleaved.AppendUtf16(u"\u00E9");
+				interleaved.AppendUtf32(U"\u20AC");
+				interleavedExpected += "x\xC3\xA9\xE2\x82\xAC";
+			}
+			assert(interleaved.Build() == String::MakeView(interleavedExpected));
+			assert(interleaved.Stats().Flushes <= interleavedExpected.length() / (StringBuilder::BUFFERSIZE - stringbuilder::MAXUTF8LENGTH) + 1);
+			for (size_t shift = 0; shift < 6; shift++)
+			{
+				// Shifting the text moves the surrogate pair across the block boundaries
+				StringBuilder small(16, 4);
+				small.Append('>');
+				small.AppendUtf16(std::u16string(shift, u'a') + utf16);
+				small.AppendUtf32(utf32);
+				assert(small.BufferSize() == 16 && small.Build() == String::MakeView(">" + std::string(shift, 'a') + expected + expected));
+			}
+			for (size_t bufferSize : { 1, 3, 4, 5, 96 })
+			{
+				// Blocks and single code points stay within the configured staging buffer, also when it is too small for one encoding
+				StringBuilder sized(bufferSize, 1);
+				sized.AppendUtf16(utf16);
+				sized.AppendUtf32(utf32);
+				sized.AppendCodepoint(U'\U0001F600');
+				assert(sized.BufferSize() == bufferSize && sized.Build() == String::MakeView(expected + expected + "\xF0\x9F\x98\x80"));
+			}
+		}
+
+		{ // Buffer configuration
+			StringBuilder tiny(16, 4);
+			tiny << "ab" << -1234567890123456789ll << "cdefgh" << 'x' << 1.25;
+			assert(tiny.Build() == "ab-1234567890123456789cdefghx1.25");
+			assert(tiny.Stats().Appends == 5 && tiny.Stats().Sections == 1 && tiny.Stats().AppendedBytes == 33);
+
+			StringBuilder large(4096, 1024);
+			StringBuilder standard;
+			std::string expected;
+			for (size_t index = 0; index < 2000; index++)
+			{
+				large << "value " << index << ", ";
+				standard << "value " << index << ", ";
+				expected += "value " + std::to_string(index) + ", ";
+			}
+			assert(large.Build() == String::MakeView(expected) && standard.Build() == String::MakeView(expected));
+			assert(large.Stats().Flushes * 16 < standard.Stats().Flushes);
+			assert(large.BufferSize() == 4096 && large.SingleThreshold() == 1024);
+
+			StringBuilder adaptive(StringBuilder::BUFFERSIZE, StringBuilder::SINGLETHRESHHOLD, true);
+			std::string mixed;
+			for (size_t index = 0; index < 2000; index++)
+			{
+				std::string field = "field" + std::to_string(index) + std::string(index % 50, '.');
+				adaptive << String::MakeManaged(field.c_str()) << ';';
+				mixed += field + ";";
+			}
+			assert(adaptive.Build() == String::MakeView(mixed));
+			assert(adaptive.BufferSize() > StringBuilder::BUFFERSIZE && adaptive.SingleThreshold() >= 64);
+			assert(adaptive.Stats().Sections < 100 && adaptive.Stats().Appends == 4000);
+			// Only adaptive builders track the distribution of append lengths
+			size_t adaptiveClassified = 0;
+			size_t standardClassified = 0;
+			for (size_t sizeClass = 0; sizeClass < StringBuilder::SIZECLASSES; sizeClass++)
+			{
+				adaptiveClassified += adaptive.Stats().SizeClasses[sizeClass];
+				standardClassified += standard.Stats().SizeClasses[sizeClass];
+			}
+			assert(adaptiveClassified == 4000 && standardClassified == 0 && standard.Stats().Appends == 6000);
+			adaptive.Clear();
+			adaptive.ResetStats();
+			assert(adaptive.Stats().Appends == 0 && adaptive.BufferSize() > StringBuilder::BUFFERSIZE);
+		}
+
+		{ // Customization point
+			static_assert(appendto::HasAppendTo<appendtotest::Point>::value && appendto::HasAppendTo<std::vector<int32_t>>::value);
+			static_assert(!appendto::HasAppendTo<appendtotest::Opaque>::value);
+
+			StringBuilder builder;
+			std::string owned = "owned";
+			builder << std::vector<int32_t>{ 1, -2, 3 } << ' ' << std::pair<String, double>("pi", 3.5) << ' ' << std::optional<int32_t>(7)
+				<< ' ' << std::optional<int32_t>() << ' ' << std::string_view("view") << ' ' << owned << ' ' << appendtotest::Color::Green;
+			owned = "changed";
+			assert(builder.Build() == "[1, -2, 3] (pi, 3.5) 7 null view owned 2");
+
+			StringBuilder nested;
+			std::vector<std::pair<appendtotest::Point, std::vector<std::string>>> values = { { { 1, 2 }, { "a", "b" } }, { { 3, 4 }, {} } };
+			nested << values;
+			assert(nested.Build() == "[(Point(1, 2), [a, b]), (Point(3, 4), [])]");
+
+			// Values are appended by reference, containers are not copied on the way
+			std::vector<appendtotest::Counted> counted(2);
+			appendtotest::Counted::Copies = 0;
+			StringBuilder referenced;
+			referenced << counted;
+			referenced.AppendLine(counted);
+			InplaceStringBuilder<64> inplaceReferenced;
+			inplaceReferenced << counted << "!";
+			char text[] = "text";
+			referenced << text;
+			char* mutableText = text;
+			referenced.Append(mutableText);
+			referenced << mutableText;
+			inplaceReferenced << mutableText;
+			assert(appendtotest::Counted::Copies == 0);
+			assert(referenced.Build() == "[counted, counted][counted, counted]\ntexttexttext" && inplaceReferenced.View() == "[counted, counted]!text");
+
+			assert(ToString(appendtotest::Point{ 5, 6 }) == "Point(5, 6)");
+			assert(ToString(std::vector<bool>{ true, false }) == "[true, false]");
+			assert(ToString(appendtotest::Color::Red) == "1");
+		}
+
+		{ // Sinks
+			std::ostringstream output;
+			StringBuilder builder;
+			builder.SetSink(output, 16);
+			builder << "0123456789";
+			assert(output.str().empty() && builder.Length() == 10);
+			builder << "abcdef" << String::MakeView(longText);
+			assert(builder.Length() == 0 && output.str() == "0123456789abcdef" + longText);
+			for (size_t index = 0; index < 40; index++)
+			{
+				builder.Append('x');
+			}
+			assert(builder.Length() < 16 && output.str().length() + builder.Length() == 156);
+			assert(builder.Flush() && builder.Length() == 0 && output.str() == "0123456789abcdef" + longText + std::string(40, 'x'));
+			builder.RemoveSink();
+			builder << String::MakeView(longText);
+			assert(builder.Length() == 100);
+			assert(!builder.Flush() && builder.Length() == 100);
+
+			// A failed write keeps the content and stops automatic writes
+			std::ostringstream broken;
+			broken.setstate(std::ios::badbit);
+			builder.SetSink(broken, 16);
+			assert(builder.Length() == 100);
+			builder << "more";
+			assert(!builder.Flush() && builder.Length() == 104 && builder.Build() == String::MakeView(longText + "more"));
+
+			// Once the sink recovers, Flush() succeeds and automatic writes resume
+			broken.clear();
+			assert(builder.Flush() && builder.Length() == 0 && broken.str() == longText + "more");
+			builder << "automatic write again";
+			assert(builder.Length() == 0 && broken.str() == longText + "moreautomatic write again");
+
+			// After a failure the next automatic write is attempted once another threshold of content was appended
+			broken.setstate(std::ios::badbit);
+			builder << "0123456789abcdefgh";
+			assert(builder.Length() == 18);
+			broken.clear();
+			builder << "0123456789";
+			assert(builder.Length() == 28);
+			builder << "abcdef";
+			assert(builder.Length() == 0 && broken.str() == longText + "moreautomatic write again0123456789abcdefgh0123456789abcdef");
+
+			std::ostringstream copy;
+			StringBuilder sections;
+			sections << "head " << String::MakeView(longText) << 42;
+			assert(sections.WriteTo(copy) && copy.str() == "head " + longText + "42");
+			assert(sections.Build() == String::MakeView(copy.str()));
+
+#ifndef _WIN32
+			FILE* file = tmpfile();
+			assert(file);
+			StringBuilder many;
+			std::string expected;
+			for (size_t index = 0; index < 200; index++)
+			{
+				many << String::MakeView(longText) << index;
+				expected += longText + std::to_string(index);
+			}
+			assert(many.WriteTo(fileno(file)));
+			std::string read(expected.length(), '\0');
+			rewind(file);
+			assert(fread(read.data(), 1, read.length(), file) == read.length() && read == expected);
+			fclose(file);
+			assert(!many.WriteTo(-1));
+#endif
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#pragma once
+#include "jhtstring.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+
+namespace jht
+{
+	inline void RunTests_StringHandle()
+	{
+		std::cout << "RunTests_StringHandle\n";
+
+		{ // Views
+			StringHandle empty;
+			assert(empty.Length() == 0 && !empty.IsManaged());
+			assert(empty.ToString() == "");
+
+			const char* text = "hello world";
+			StringHandle view(String(text, 5));
+			assert(!view.IsManaged() && view.Length() == 5 && view.ConstData() == text);
+			String back = view.ToString();
+			assert(!back.IsManaged() && back.ConstData() == text && back == "hello");
+			assert(view == StringHandle("hello") && view != StringHandle("hell"));
+
+			// Views too long for the spare pointer bits become managed copies
+			std::string longText(StringHandle::MAXVIEWLENGTH + 1, 'x');
+			StringHandle copied(String::MakeView(longText));
+			assert(copied.IsManaged() && copied.Length() == longText.size() && copied.ConstData() != longText.data());
+		}
+
+		{ // Managed data is shared, not copied
+			String managed = String::MakeManaged("managed text");
+			StringHandle handle(managed);
+			assert(handle.IsManaged() && handle.Length() == 12 && handle.ConstData() == managed.ConstData());
+
+			String back = handle.ToString();
+			assert(back.IsManaged() && back.ConstData() == managed.ConstData() && back.Length() == 12);
+
+			StringHandle copy(handle);
+			StringHandle moved(std::move(copy));
+			assert(copy.Length() == 0 && moved == handle);
+			copy = moved;
+			moved = String("view");
+			assert(!moved.IsManaged() && moved.ToString() == "view");
+			handle = std::move(copy);
+			assert(handle.ToString() == "managed text");
+
+			managed = String();
+			back = String();
+			assert(handle.ToString() == "managed text");
+		}
+
+		{ // Collections
+			std::vector<StringHandle> handles;
+			for (int32_t i = 0; i < 100; i++)
+			{
+				handles.push_back(i % 2 ? String::MakeManaged(std::to_string(i)) : String("even"));
+			}
+			std::vector<StringHandle> copies = handles;
+			for (int32_t i = 0; i < 100; i++)
+			{
+				assert(copies[i].ToString() == (i % 2 ? String::MakeManaged(std::to_string(i)) : String("even")));
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,65 @@
+#pragma once
+#include "jhtstring.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+
+namespace jht
+{
+	enum class HttpMethod
+	{
+		Get,
+		Head,
+		Post,
+		Put,
+		Delete,
+		Connect,
+		Options,
+		Trace,
+		Patch,
+		Unknown
+	};
+
+	inline void RunTests_StringSwitch()
+	{
+		std::cout << "RunTests_StringSwitch\n";
+
+		{ // Built at compile time
+			constexpr StringSwitch methods({ "GET", "HEAD", "POST", "PUT", "DELETE", "CONNECT", "OPTIONS", "TRACE", "PATCH" });
+			static_assert(methods.Count() == 9);
+			static_assert(methods.Find("PUT") == 3);
+			static_assert(methods.Find("PATCH") == 8);
+			static_assert(methods.Find("PU") == StringSwitch<9>::NOTFOUND);
+			static_assert(methods.Find("") == StringSwitch<9>::NOTFOUND);
+
+			HttpMethod method = HttpMethod::Unknown;
+			assert(methods.TryFind("DELETE", method) && method == HttpMethod::Delete);
+			assert(!methods.TryFind("delete", method) && method == HttpMethod::Delete);
+			assert(methods.Find(String::MakeManaged("OPTIONS")) == 6);
+
+			assert(TryParse(" TRACE\n", method, methods, HttpMethod::Unknown) && method == HttpMethod::Trace);
+			assert(!TryParse("TRACEX", method, methods, HttpMethod::Unknown) && method == HttpMethod::Unknown);
+		}
+
+		{ // Larger sets, built at run time
+			static const std::string_view keys[] = {
+				"alignas", "alignof", "and", "asm", "auto", "bool", "break", "case", "catch", "char", "class", "const", "consteval",
+				"constexpr", "constinit", "continue", "decltype", "default", "delete", "do", "double", "else", "enum", "explicit",
+				"export", "extern", "false", "float", "for", "friend", "goto", "if", "inline", "int", "long", "mutable", "namespace",
+				"new", "noexcept", "not", "nullptr", "operator", "or", "private", "protected", "public", "register", "return", "short",
+				"signed", "sizeof", "static", "struct", "switch", "template", "this", "throw", "true", "try", "typedef", "typeid",
+				"typename", "union", "unsigned", "using", "virtual", "void", "volatile", "while", "xor", "", "a", "b"
+			};
+			StringSwitch keywords(keys);
+			for (size_t index = 0; index < keywords.Count(); index++)
+			{
+				assert(keywords.Find(String(keys[index].data(), keys[index].size())) == index);
+			}
+			const char* others[] = { "c", "ab", "classes", "Class", "whil", "volatile ", "\xFF" };
+			for (const char* other : others)
+			{
+				assert(keywords.Find(other) == StringSwitch<73>::NOTFOUND);
+			}
+		}
+	}
+}
\ No newline at end of file
@@ -0,0 +1,80 @@
+#pragma once
+#include "jhtstring.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+
+namespace jht
+{
+	inline void RunTests_SymbolTable()
+	{
+		std::cout << "RunTests_SymbolTable\n";
+
+		{ // Untrained table escapes every byte
+			SymbolTable table;
+			assert(table.SymbolCount() == 0);
+			String compressed = table.Compress("ab\xFF");
+			assert(compressed.Length() == 6);
+			assert(table.Decompress(compressed) == "ab\xFF");
+			assert(table.Compress("").Length() == 0);
+			assert(table.Decompress("").Length() == 0);
+		}
+
+		{ // Trained on repetitive values
+			const char* hosts[] = { "www.example.com", "api.example.org", "cdn.jht.net", "static.example.com" };
+			const char* paths[] = { "/index.html", "/api/v1/users", "/images/logo.png", "/api/v2/orders?id=" };
+			std::vector<std::string> storage;
+			uint32_t seed = 3;
+			for (int32_t i = 0; i < 2000; i++)
+			{
+				seed = seed * 1103515245 + 12345;
+				std::string url = (seed & 0x10000) ? "https://" : "http://";
+				url += hosts[(seed >> 17) % 4];
+				url += paths[(seed >> 20) % 4];
+				url += std::to_string((seed >> 8) % 1000);
+				storage.push_back(url);
+			}
+			std::vector<String> values;
+			for (const std::string& url : storage)
+			{
+				values.push_back(String::MakeView(url));
+			}
+
+			SymbolTable table;
+			table.Train(values);
+			assert(table.SymbolCount() > 0 && table.SymbolCount() <= SymbolTable::MAXSYMBOLS);
+			for (size_t code = 0; code < table.SymbolCount(); code++)
+			{
+				size_t length = table.Symbol(code).Length();
+				assert(length >= 1 && length <= SymbolTable::MAXSYMBOLLENGTH);
+			}
+
+			size_t originalBytes = 0;
+			size_t compressedBytes = 0;
+			for (const String& value : values)
+			{
+				String compressed = table.Compress(value);
+				assert(compressed.Length() <= SymbolTable::MaxCompressedLength(value.Length()));
+				assert(table.DecompressedLength(compressed) == value.Length());
+				assert(table.Decompress(compressed) == value);
+				originalBytes += value.Length();
+				compressedBytes += compressed.Length();
+			}
+			assert(compressedBytes * 2 < originalBytes);
+
+			// Bytes never seen in training still round trip
+			String unseen("\x01\xFF\x00ZZ~https://www.example.com/", 29);
+			assert(table.Decompress(table.Compress(unseen)) == unseen);
+
+			// Saving and loading
+			SymbolTable loaded;
+			assert(loaded.TryLoad(table.Save()));
+			assert(loaded.SymbolCount() == table.SymbolCount());
+			assert(loaded.Compress(values[0]) == table.Compress(values[0]));
+			assert(!loaded.TryLoad(""));
+			assert(!loaded.TryLoad(String("\x01\x09", 2)));
+			assert(!loaded.TryLoad(String("\x01\x02" "a", 3)));
+			assert(loaded.SymbolCount() == table.SymbolCount());
+		}
+	}
+}
\ No newline at end of file
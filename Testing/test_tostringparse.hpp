@@ -1,5 +1,10 @@
 #pragma once
 #include "jhtstring.hpp"
+#include <cctype>
+#include <charconv>
+#include <cfloat>
+#include <cmath>
+#include <cstdlib>
 
 namespace jht
 {
@@ -21,6 +26,46 @@ namespace jht
 		assert(abs(value - output) < epsilon);
 	}
 
+	/// @brief Significant digits of a formatted number, without sign, decimal point, exponent, leading and trailing zeros
+	inline std::string SignificantDigits(const char* text, size_t length)
+	{
+		std::string digits;
+		for (size_t index = 0; index < length && text[index] != 'e'; index++)
+		{
+			if (isdigit(static_cast<unsigned char>(text[index])) && (!digits.empty() || text[index] != '0'))
+			{
+				digits.push_back(text[index]);
+			}
+		}
+		while (!digits.empty() && digits.back() == '0')
+		{
+			digits.pop_back();
+		}
+		return digits;
+	}
+
+	/// @brief Checks that the shortest formatting of value parses back exactly and has the digits of std::to_chars
+	template<typename T>
+	inline void CheckShortest(T value)
+	{
+		char actual[tochars::MAXSHORTESTLENGTH + 1];
+		char expected[64];
+		size_t length = ToChars(actual, value);
+		assert(length <= tochars::MAXSHORTESTLENGTH);
+		actual[length] = 0;
+		if constexpr (std::is_same<T, float>::value)
+		{
+			assert(strtof(actual, nullptr) == value);
+		}
+		else
+		{
+			assert(strtod(actual, nullptr) == value);
+		}
+		assert(std::signbit(strtod(actual, nullptr)) == std::signbit(value));
+		size_t expectedLength = static_cast<size_t>(std::to_chars(expected, expected + sizeof(expected), value, std::chars_format::scientific).ptr - expected);
+		assert(SignificantDigits(actual, length) == SignificantDigits(expected, expectedLength));
+	}
+
 	inline void RunTests_ToStringParse()
 	{
 		std::cout << "RunTests_ToStringParse\n";
@@ -48,5 +93,92 @@ namespace jht
 		assert(TryParse("1234567890", uintResult));
 		assert(TryParse("1234567890", fpResult));
 
+		// Integer formatting matches std::to_chars for every width and radius
+		uint64_t state = 0x9E3779B97F4A7C15ull;
+		for (int32_t iteration = 0; iteration < 20000; iteration++)
+		{
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			uint64_t value = state >> (iteration % 64);
+			for (int32_t radius : { 2, 3, 8, 10, 16 })
+			{
+				char expected[tochars::MAXINTEGERLENGTH];
+				char actual[tochars::MAXINTEGERLENGTH];
+				auto check = [&](auto typed)
+				{
+					size_t length = static_cast<size_t>(std::to_chars(expected, expected + sizeof(expected), typed, radius).ptr - expected);
+					for (size_t index = 0; index < length; index++)
+					{
+						expected[index] = static_cast<char>(toupper(expected[index]));
+					}
+					assert(ToChars(actual, typed, radius) == length && memcmp(actual, expected, length) == 0);
+				};
+				check(value);
+				check(static_cast<int64_t>(value));
+				check(static_cast<uint32_t>(value));
+				check(static_cast<int32_t>(value));
+				check(static_cast<int16_t>(value));
+				check(static_cast<uint8_t>(value));
+			}
+		}
+		assert(ToString(int8_t(-128)) == "-128" && ToString(uint16_t(65535), 16) == "FFFF" && ToString(INT64_MIN, 2).Length() == 65);
+		for (int32_t radius : { 2, 8, 10, 16 })
+		{
+			char buffer[tochars::MAXINTEGERLENGTH];
+			assert(ToChars(buffer, INT64_MIN, radius) <= tochars::MaxIntegerLength(radius) && ToChars(buffer, UINT64_MAX, radius) <= tochars::MaxIntegerLength(radius));
+		}
+		assert(ToString(INT64_MIN).Length() == tochars::MAXDECIMALLENGTH<int64_t> && ToString(UINT64_MAX).Length() == tochars::MAXDECIMALLENGTH<uint64_t>);
+		assert(ToString(INT32_MIN).Length() == tochars::MAXDECIMALLENGTH<int32_t> && ToString(UINT32_MAX).Length() == tochars::MAXDECIMALLENGTH<uint32_t>);
+
+		// Shortest round trip formatting of floating point values
+		assert(ToStringShortest(0.0) == "0" && ToStringShortest(-0.0) == "-0");
+		assert(ToStringShortest(1.0) == "1" && ToStringShortest(-1.5) == "-1.5" && ToStringShortest(0.1) == "0.1");
+		assert(ToStringShortest(123456.0) == "123456" && ToStringShortest(1e20) == "100000000000000000000");
+		assert(ToStringShortest(1e21) == "1e+21" && ToStringShortest(1.5e300) == "1.5e+300");
+		assert(ToStringShortest(0.000001) == "0.000001" && ToStringShortest(1e-7) == "1e-7" && ToStringShortest(1.25e-7) == "1.25e-7");
+		assert(ToStringShortest(5e-324) == "5e-324" && ToStringShortest(DBL_MAX) == "1.7976931348623157e+308");
+		assert(ToStringShortest(0.1 + 0.2) == "0.30000000000000004" && ToStringShortest(9007199254740993.0) == "9007199254740992");
+		assert(ToStringShortest(0.1f) == "0.1" && ToStringShortest(16777216.0f) == "16777216" && ToStringShortest(FLT_MAX) == "3.4028235e+38");
+		assert(ToStringShortest(NAN) == "nan" && ToStringShortest(INFINITY) == "inf" && ToStringShortest(-INFINITY) == "-inf");
+		assert(ToString(1e300).Length() < tochars::MAXDOUBLELENGTH && ToString(-INFINITY) == "-inf");
+		for (double value : { 5e-324, 2.2250738585072014e-308, 2.2250738585072009e-308, 1e23, 9007199254740991.0, 0.3, 2.0 / 3.0, 1e-5, 123.456 })
+		{
+			CheckShortest(value);
+			CheckShortest(-value);
+		}
+		for (float value : { 1e-45f, 1.17549435e-38f, 3.3554448e7f, 8.388608e6f, 0.3f, 1.0f / 3.0f, 7.038531e-26f })
+		{
+			CheckShortest(value);
+			CheckShortest(-value);
+		}
+		for (int32_t iteration = 0; iteration < 200000; iteration++)
+		{
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			double value = std::bit_cast<double>(state);
+			if (std::isfinite(value))
+			{
+				CheckShortest(value);
+			}
+			float single = std::bit_cast<float>(static_cast<uint32_t>(state >> 32));
+			if (std::isfinite(single))
+			{
+				CheckShortest(single);
+			}
+			// Values with few digits take the paths where the interval bounds are exact
+			CheckShortest(static_cast<double>(static_cast<int64_t>(state % 2000001) - 1000000) / 1000.0);
+			CheckShortest(static_cast<float>(state % 100001) / 100.0f);
+		}
+
+		StringBuilder builder;
+		builder.AppendShortest(0.1);
+		builder << ' ';
+		builder.AppendShortest(2.5e-10f);
+		assert(builder.Build() == "0.1 2.5e-10");
+		InplaceStringBuilder<8> inplace;
+		inplace.AppendShortest(1.0 / 3.0);
+		assert(inplace.View() == "0.333333" && inplace.Overflowed());
 	}
 }
\ No newline at end of file
@@ -0,0 +1,106 @@
+#pragma once
+#include "jhtstring.hpp"
+#include <cassert>
+#include <iostream>
+#include <string>
+
+namespace jht
+{
+	inline void RunTests_TrigramIndex()
+	{
+		std::cout << "RunTests_TrigramIndex\n";
+
+		{ // Incremental insertion
+			TrigramIndex index;
+			assert(index.Add("hello world") == 0);
+			assert(index.Add("yellow") == 1);
+			assert(index.Add("ab") == 2);
+			assert(index.Add("low tide") == 3);
+			assert(index.Count() == 4);
+			assert(index.Get(1) == "yellow");
+
+			std::vector<size_t> found;
+			index.FindContaining("llo", found);
+			assert(found == std::vector<size_t>({ 0, 1 }));
+			index.FindContaining("low", found);
+			assert(found == std::vector<size_t>({ 1, 3 }));
+			index.FindContaining("b", found);
+			assert(found == std::vector<size_t>({ 2 }));
+			index.FindContaining("", found);
+			assert(found.size() == 4);
+			index.FindContaining("xyz", found);
+			assert(found.empty());
+			index.FindContaining("hello world!", found);
+			assert(found.empty());
+
+			assert(index.FindMatching("*llo*", found));
+			assert(found == std::vector<size_t>({ 0, 1 }));
+			assert(index.FindMatching("hel?o w*", found));
+			assert(found == std::vector<size_t>({ 0 }));
+			assert(index.FindMatching("{yel,}low*", found));
+			assert(found == std::vector<size_t>({ 1, 3 }));
+			assert(!index.FindMatching("[abc", found));
+
+			index.Clear();
+			assert(index.Count() == 0);
+		}
+
+		{ // Bulk build compared against a sequential build and a linear scan
+			const char* words[] = { "alpha", "beta", "gamma", "delta", "/api/", "user", "order", "42", "\xF0\x9F\x98\x80", "-" };
+			std::vector<std::string> storage;
+			uint32_t seed = 11;
+			for (int32_t i = 0; i < 20000; i++)
+			{
+				std::string value;
+				seed = seed * 1103515245 + 12345;
+				size_t count = (seed >> 16) % 5;
+				for (size_t w = 0; w < count; w++)
+				{
+					seed = seed * 1103515245 + 12345;
+					value += words[(seed >> 16) % 10];
+				}
+				storage.push_back(value);
+			}
+			std::vector<String> values;
+			for (const std::string& value : storage)
+			{
+				values.push_back(String::MakeView(value));
+			}
+
+			TrigramIndex parallel;
+			parallel.Add("prefix value");
+			parallel.AddRange(values, 4);
+			TrigramIndex sequential;
+			sequential.Add("prefix value");
+			sequential.AddRange(values, 1);
+			assert(parallel.Count() == values.size() + 1);
+			assert(parallel.MemoryUsage() == sequential.MemoryUsage());
+
+			const char* needles[] = { "alpha", "tabe", "a/api/u", "42-", "\x80" "ga", "deltadelta", "xx", "r", "pre" };
+			for (const char* needle : needles)
+			{
+				std::vector<size_t> expected;
+				for (size_t id = 0; id < parallel.Count(); id++)
+				{
+					const String& value = parallel.Get(id);
+					if (std::string(value.ConstData(), value.Length()).find(needle) != std::string::npos)
+					{
+						expected.push_back(id);
+					}
+				}
+				std::vector<size_t> found;
+				parallel.FindContaining(needle, found);
+				assert(found == expected);
+				sequential.FindContaining(needle, found);
+				assert(found == expected);
+			}
+
+			std::vector<size_t> found;
+			assert(parallel.FindMatching("alpha*order", found));
+			for (size_t id : found)
+			{
+				assert(storage[id - 1].rfind("alpha", 0) == 0);
+			}
+		}
+	}
+}
\ No newline at end of file